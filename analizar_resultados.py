@@ -38,7 +38,13 @@ def procesar_resultados(directorio_resultados='Resultados'):
                 ruta_completa = os.path.join(directorio_resultados, archivo)
                 with open(ruta_completa, 'r') as f:
                     tiempos = []
+                    energias = []
                     for linea in f:
+                        # Líneas "ENERGIA julios=J gflop_j=G vatios=W" (RAPL)
+                        if linea.startswith('ENERGIA '):
+                            campos = dict(p.split('=') for p in linea.split()[1:])
+                            energias.append((float(campos['julios']), float(campos['gflop_j'])))
+                            continue
                         try:
                             tiempo = float(linea.strip())
                             # Filtrar outliers extremos (> 1 hora en microsegundos)
@@ -56,7 +62,9 @@ def procesar_resultados(directorio_resultados='Resultados'):
                             'Tiempo_Min': np.min(tiempos),
                             'Tiempo_Max': np.max(tiempos),
                             'Desv_Std': np.std(tiempos),
-                            'Repeticiones': len(tiempos)
+                            'Repeticiones': len(tiempos),
+                            'Energia_J': np.mean([e[0] for e in energias]) if energias else np.nan,
+                            'GFLOP_J': np.mean([e[1] for e in energias]) if energias else np.nan
                         })
                         archivos_procesados += 1
                     else:
@@ -240,6 +248,137 @@ def generar_grafica_comparativa_general(df):
     plt.close()
     print(f"✓ Generada: grafica_comparativa_general.png")
 
+def generar_graficas_escalamiento(df_esc):
+    """
+    Genera gráficas de escalamiento fuerte (speedup) y débil (eficiencia)
+    a partir de Resultados/escalamiento.csv
+    """
+    fig, (ax1, ax2) = plt.subplots(1, 2, figsize=(16, 6))
+    
+    # Escalamiento fuerte: speedup = T(1) / T(p) con N fijo
+    fuerte = df_esc[df_esc['Tipo'] == 'fuerte']
+    for programa in sorted(fuerte['Programa'].unique()):
+        datos = fuerte[fuerte['Programa'] == programa].sort_values('Hilos')
+        base = datos[datos['Hilos'] == 1]
+        if base.empty:
+            continue
+        ax1.plot(datos['Hilos'], base['Tiempo_Promedio'].values[0] / datos['Tiempo_Promedio'],
+                marker='o', label=programa, linewidth=2, markersize=7)
+    if not fuerte.empty:
+        hilos = sorted(fuerte['Hilos'].unique())
+        ax1.plot(hilos, hilos, 'k--', alpha=0.5, label='Speedup Ideal')
+        ax1.set_title(f'Escalamiento Fuerte (N={int(fuerte["Tamano"].iloc[0])})',
+                     fontsize=14, fontweight='bold')
+    ax1.set_xlabel('Número de Hilos/Procesos', fontsize=12, fontweight='bold')
+    ax1.set_ylabel('Speedup', fontsize=12, fontweight='bold')
+    ax1.legend(fontsize=9)
+    ax1.grid(True, alpha=0.3)
+    
+    # Escalamiento débil: eficiencia = T(1) / T(p) con trabajo por hilo fijo
+    debil = df_esc[df_esc['Tipo'] == 'debil']
+    for programa in sorted(debil['Programa'].unique()):
+        datos = debil[debil['Programa'] == programa].sort_values('Hilos')
+        base = datos[datos['Hilos'] == 1]
+        if base.empty:
+            continue
+        eficiencia = base['Tiempo_Promedio'].values[0] / datos['Tiempo_Promedio'] * 100
+        ax2.plot(datos['Hilos'], eficiencia, marker='s', label=programa, linewidth=2, markersize=7)
+    ax2.axhline(y=100, color='red', linestyle='--', alpha=0.5)
+    ax2.set_xlabel('Número de Hilos/Procesos', fontsize=12, fontweight='bold')
+    ax2.set_ylabel('Eficiencia Débil (%)', fontsize=12, fontweight='bold')
+    ax2.set_title('Escalamiento Débil (N ∝ p^(1/3))', fontsize=14, fontweight='bold')
+    ax2.legend(fontsize=9)
+    ax2.grid(True, alpha=0.3)
+    
+    plt.tight_layout()
+    plt.savefig('grafica_escalamiento.png', dpi=300, bbox_inches='tight')
+    plt.close()
+    print(f"✓ Generada: grafica_escalamiento.png")
+
+def generar_grafica_roofline(df_esc, df_techos):
+    """
+    Genera el roofline con el máximo de hilos medido y clasifica cada
+    programa como limitado por cómputo o por memoria
+    """
+    hilos_max = df_techos['Hilos'].max()
+    techo = df_techos[df_techos['Hilos'] == hilos_max].iloc[0]
+    pico, banda = techo['Pico_GFLOPS'], techo['Ancho_Banda_GBs']
+    punto_quiebre = pico / banda
+    
+    fig, ax = plt.subplots(figsize=(12, 8))
+    
+    # Techo: min(pico, intensidad × ancho de banda)
+    intensidades = np.logspace(-2, 3, 200)
+    ax.plot(intensidades, np.minimum(pico, intensidades * banda), 'k-', linewidth=2.5,
+           label=f'Techo ({hilos_max} hilos): {pico:.1f} GFLOP/s, {banda:.1f} GB/s')
+    ax.axvline(x=punto_quiebre, color='gray', linestyle=':', alpha=0.7)
+    
+    # Un punto por programa: escalamiento fuerte con el máximo de hilos
+    puntos = df_esc[(df_esc['Tipo'] == 'fuerte') & (df_esc['Hilos'] == hilos_max)]
+    markers = ['o', 's', '^', 'D', 'v', 'P']
+    print(f"  Punto de quiebre del roofline: {punto_quiebre:.2f} FLOP/byte")
+    for idx, (_, fila) in enumerate(puntos.iterrows()):
+        limite = 'cómputo' if fila['Intensidad'] >= punto_quiebre else 'memoria'
+        alcanzable = min(pico, fila['Intensidad'] * banda)
+        ax.plot(fila['Intensidad'], fila['GFLOPS'], marker=markers[idx % len(markers)],
+               markersize=11, linestyle='none', label=f"{fila['Programa']} (limitado por {limite})")
+        print(f"  {fila['Programa']}: {fila['GFLOPS']:.2f} GFLOP/s de {alcanzable:.2f} alcanzables "
+              f"({fila['GFLOPS'] / alcanzable * 100:.0f}%), limitado por {limite}")
+    
+    ax.set_xscale('log')
+    ax.set_yscale('log')
+    ax.set_xlabel('Intensidad Aritmética (FLOP/byte)', fontsize=13, fontweight='bold')
+    ax.set_ylabel('Rendimiento (GFLOP/s)', fontsize=13, fontweight='bold')
+    ax.set_title('Modelo Roofline', fontsize=15, fontweight='bold', pad=20)
+    ax.legend(fontsize=10, loc='lower right')
+    ax.grid(True, which='both', alpha=0.3, linestyle='--')
+    
+    plt.tight_layout()
+    plt.savefig('grafica_roofline.png', dpi=300, bbox_inches='tight')
+    plt.close()
+    print(f"✓ Generada: grafica_roofline.png")
+
+def generar_grafica_energia(df):
+    """
+    Genera gráficas de energía (J) y eficiencia energética (GFLOP/J)
+    por programa y número de hilos, si hay mediciones RAPL
+    """
+    df_energia = df.dropna(subset=['GFLOP_J'])
+    if df_energia.empty:
+        print("  Sin mediciones de energía (RAPL no disponible o desactivado), se omite")
+        return
+    
+    # Tamaño más grande con mediciones de energía
+    tamano = df_energia['Tamano'].max()
+    datos_tam = df_energia[df_energia['Tamano'] == tamano]
+    
+    fig, (ax1, ax2) = plt.subplots(1, 2, figsize=(16, 6))
+    
+    for programa in sorted(datos_tam['Programa'].unique()):
+        datos = datos_tam[datos_tam['Programa'] == programa].sort_values('Hilos')
+        ax1.plot(datos['Hilos'], datos['Energia_J'], marker='o', label=programa, linewidth=2)
+        ax2.plot(datos['Hilos'], datos['GFLOP_J'], marker='s', label=programa, linewidth=2)
+        mejor = datos.loc[datos['GFLOP_J'].idxmax()]
+        print(f"  {programa}: mejor eficiencia con {int(mejor['Hilos'])} hilos "
+              f"({mejor['GFLOP_J']:.3f} GFLOP/J, {mejor['Energia_J']:.1f} J)")
+    
+    ax1.set_xlabel('Número de Hilos/Procesos', fontsize=12, fontweight='bold')
+    ax1.set_ylabel('Energía (J)', fontsize=12, fontweight='bold')
+    ax1.set_title(f'Energía por Multiplicación (N={tamano})', fontsize=14, fontweight='bold')
+    ax1.legend()
+    ax1.grid(True, alpha=0.3)
+    
+    ax2.set_xlabel('Número de Hilos/Procesos', fontsize=12, fontweight='bold')
+    ax2.set_ylabel('GFLOP/J', fontsize=12, fontweight='bold')
+    ax2.set_title(f'Eficiencia Energética (N={tamano})', fontsize=14, fontweight='bold')
+    ax2.legend()
+    ax2.grid(True, alpha=0.3)
+    
+    plt.tight_layout()
+    plt.savefig('grafica_energia.png', dpi=300, bbox_inches='tight')
+    plt.close()
+    print(f"✓ Generada: grafica_energia.png")
+
 def generar_tablas_latex(df):
     """
     Genera tablas en formato LaTeX
@@ -356,6 +495,15 @@ def main():
     generar_graficas_speedup(df)
     generar_grafica_eficiencia(df)
     generar_grafica_comparativa_general(df)
+    generar_grafica_energia(df)
+    
+    # Escalamiento y roofline (generados por escalamiento.py)
+    if Path('Resultados/escalamiento.csv').exists() and Path('Resultados/techos.csv').exists():
+        print("\n📐 Generando escalamiento y roofline...")
+        df_esc = pd.read_csv('Resultados/escalamiento.csv')
+        df_techos = pd.read_csv('Resultados/techos.csv')
+        generar_graficas_escalamiento(df_esc)
+        generar_grafica_roofline(df_esc, df_techos)
     
     # Generar tablas LaTeX
     print("\n📋 Generando tablas LaTeX...")
@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+"""
+Suite de Escalamiento y Roofline - Taller de Evaluación de Rendimiento
+Autores: Juan David Garzon Ballen, Juan Pablo Sanchez
+Pontificia Universidad Javeriana - Sistemas Operativos
+
+Ejecuta dos experimentos por programa y número de hilos, configurados en
+la sección [escalamiento] de barrido.conf:
+- Escalamiento fuerte: N fijo (tamano_fuerte), más hilos para el mismo trabajo
+- Escalamiento débil: N crece con los hilos, N(p) = N0 × p^(1/3), de modo
+  que el trabajo por hilo (2N³/p operaciones) se mantiene constante
+
+Además mide con mmRoofline los techos de la máquina (pico de GFLOP/s y
+ancho de banda en GB/s) para cada número de hilos, y estima la intensidad
+aritmética de cada ejecución. analizar_resultados.py usa estos datos para
+dibujar el roofline y decidir si un programa está limitado por cómputo o
+por memoria.
+
+Salidas (en el directorio de resultados):
+- escalamiento.csv: Tipo, Programa, Hilos, Tamano, tiempos, GFLOPS, Intensidad
+- techos.csv: Hilos, Pico_GFLOPS, Ancho_Banda_GBs
+
+Solo usa la biblioteca estándar de Python.
+"""
+
+import argparse
+import configparser
+import csv
+import os
+import statistics
+import subprocess
+import sys
+
+from orquestador import ejecutar_una_vez, leer_configuracion, separar_programa
+
+# Lado de bloque con reutilización en caché de los núcleos por bloques
+# (BASE_RECURSIVA de mmCommon.c y bloque por defecto de mmBloquesOpenMP)
+BLOQUE_EFECTIVO = {'mmRecursivaOpenMP': 32, 'mmBloquesOpenMP': 64,
+                   'mmClasicaFork:recursiva': 32, 'mmClasicaPosix:recursiva': 32}
+
+
+def leer_escalamiento(ruta):
+    """
+    Lee la sección [escalamiento] de barrido.conf
+    """
+    cfg = configparser.ConfigParser()
+    cfg.read(ruta, encoding='utf-8')
+    if not cfg.has_section('escalamiento'):
+        sys.exit(f"[ERROR] Falta la sección [escalamiento] en {ruta}")
+
+    return {
+        'programas': cfg.get('escalamiento', 'programas').split(),
+        'hilos': [int(x) for x in cfg.get('escalamiento', 'hilos').split()],
+        'tamano_fuerte': cfg.getint('escalamiento', 'tamano_fuerte'),
+        'tamano_base_debil': cfg.getint('escalamiento', 'tamano_base_debil'),
+        'repeticiones': cfg.getint('escalamiento', 'repeticiones'),
+    }
+
+
+def tamano_cache_ultimo_nivel():
+    """
+    Tamaño en bytes de la caché de último nivel (8 MB si no se puede leer)
+    """
+    try:
+        tam = os.sysconf('SC_LEVEL3_CACHE_SIZE')
+        if tam > 0:
+            return tam
+    except (ValueError, OSError):
+        pass
+
+    try:
+        with open('/sys/devices/system/cpu/cpu0/cache/index3/size') as f:
+            texto = f.read().strip()
+        multiplicador = {'K': 1024, 'M': 1024 * 1024}.get(texto[-1], 1)
+        return int(texto.rstrip('KM')) * multiplicador
+    except (OSError, ValueError):
+        return 8 * 1024 * 1024
+
+
+def intensidad_aritmetica(programa, n, llc):
+    """
+    Estima FLOP por byte de memoria principal para un producto N x N
+
+    Modelo de tráfico (el mínimo obligatorio es leer A y B y escribir C):
+    - Si B (o B^T) cabe en la caché de último nivel, solo hay tráfico
+      obligatorio, sea cual sea el núcleo
+    - Núcleos por bloques de lado b: cada producto de bloques trae un
+      bloque de A y uno de B, en total 2 × 8N³/b bytes
+    - Núcleos por filas (clásico y transpuesta): B se vuelve a leer de
+      memoria por cada fila de C (8N³ bytes)
+    """
+    flops = 2.0 * n ** 3
+    obligatorio = 3 * 8.0 * n * n
+
+    if 8.0 * n * n <= llc:
+        trafico = obligatorio
+    elif programa in BLOQUE_EFECTIVO:
+        trafico = 2 * 8.0 * n ** 3 / BLOQUE_EFECTIVO[programa] + obligatorio
+    else:
+        trafico = 8.0 * n ** 3 + obligatorio
+    return flops / trafico
+
+
+def medir_techos(hilos, nucleos):
+    """
+    Ejecuta mmRoofline con el número de hilos dado y devuelve sus techos
+    """
+    def fijar_nucleos():
+        os.sched_setaffinity(0, nucleos)
+
+    proceso = subprocess.run(['./mmRoofline', str(hilos)], stdout=subprocess.PIPE,
+                             text=True, preexec_fn=fijar_nucleos, check=True)
+    techos = {}
+    for linea in proceso.stdout.splitlines():
+        clave, _, valor = linea.partition(' ')
+        techos[clave] = float(valor)
+    return techos['PICO_GFLOPS'], techos['ANCHO_BANDA_GBS']
+
+
+def medir(programa, n, hilos, repeticiones, nucleos):
+    """
+    Ejecuta una configuración varias veces y devuelve (promedio, desviación)
+    """
+    tiempos = []
+    for _ in range(repeticiones):
+        tiempo, _ = ejecutar_una_vez(programa, n, hilos, nucleos)
+        if tiempo is None:
+            return None
+        tiempos.append(tiempo)
+    return statistics.mean(tiempos), statistics.pstdev(tiempos)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Escalamiento fuerte/débil y roofline')
+    parser.add_argument('--config', default='barrido.conf', help='archivo de configuración')
+    parser.add_argument('--solo-techos', action='store_true',
+                        help='solo mide los techos de la máquina (techos.csv)')
+    args = parser.parse_args()
+
+    base = leer_configuracion(args.config)
+    esc = leer_escalamiento(args.config)
+    directorio, nucleos = base['directorio'], base['nucleos']
+    os.makedirs(directorio, exist_ok=True)
+
+    for programa in ['mmRoofline'] + esc['programas']:
+        ejecutable, _ = separar_programa(programa)
+        if not os.access(f'./{ejecutable}', os.X_OK):
+            sys.exit(f"[ERROR] No se encuentra el ejecutable: {ejecutable}\n"
+                     f"        Ejecute: make all")
+
+    print("=" * 60)
+    print("  SUITE DE ESCALAMIENTO Y ROOFLINE")
+    print("=" * 60)
+
+    # Techos de la máquina por número de hilos
+    with open(os.path.join(directorio, 'techos.csv'), 'w', newline='') as f:
+        escritor = csv.writer(f)
+        escritor.writerow(['Hilos', 'Pico_GFLOPS', 'Ancho_Banda_GBs'])
+        for hilos in esc['hilos']:
+            pico, banda = medir_techos(hilos, nucleos)
+            escritor.writerow([hilos, f"{pico:.3f}", f"{banda:.3f}"])
+            print(f"Techos con {hilos:2d} hilos: {pico:8.2f} GFLOP/s, {banda:7.2f} GB/s")
+
+    if args.solo_techos:
+        return
+
+    llc = tamano_cache_ultimo_nivel()
+    print(f"Caché de último nivel: {llc // 1024} KB")
+
+    with open(os.path.join(directorio, 'escalamiento.csv'), 'w', newline='') as f:
+        escritor = csv.writer(f)
+        escritor.writerow(['Tipo', 'Programa', 'Hilos', 'Tamano', 'Tiempo_Promedio',
+                           'Desv_Std', 'GFLOPS', 'Intensidad'])
+
+        for tipo in ('fuerte', 'debil'):
+            print(f"\nEscalamiento {tipo}:")
+            for programa in esc['programas']:
+                for hilos in esc['hilos']:
+                    if tipo == 'fuerte':
+                        n = esc['tamano_fuerte']
+                    else:
+                        n = int(round(esc['tamano_base_debil'] * hilos ** (1.0 / 3.0)))
+
+                    resultado = medir(programa, n, hilos, esc['repeticiones'], nucleos)
+                    if resultado is None:
+                        print(f"  [ERROR] {programa} N={n} hilos={hilos}: falló la ejecución")
+                        continue
+
+                    promedio, desviacion = resultado
+                    gflops = 2.0 * n ** 3 / (promedio * 1e3)
+                    escritor.writerow([tipo, programa, hilos, n, f"{promedio:.0f}",
+                                       f"{desviacion:.0f}", f"{gflops:.3f}",
+                                       f"{intensidad_aritmetica(programa, n, llc):.4f}"])
+                    f.flush()
+                    print(f"  {programa:20s} N={n:5d} hilos={hilos:2d}: "
+                          f"{promedio / 1e6:8.3f} s, {gflops:7.2f} GFLOP/s")
+
+    print("\n" + "=" * 60)
+    print(f"Datos en {directorio}/escalamiento.csv y {directorio}/techos.csv")
+    print("Gráficas: python3 analizar_resultados.py")
+    print("=" * 60)
+
+
+if __name__ == "__main__":
+    main()
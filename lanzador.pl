@@ -21,6 +21,7 @@
 #     
 #     Formato de salida:
 #     - Archivos: Resultados/[ejecutable]-[size]-Hilos-[num].dat
+#       (Resultados/[ejecutable]_[núcleo]-... si se elige $Nucleo)
 #     - Cada línea del archivo contiene el tiempo en microsegundos
 #     - Los archivos pueden importarse a Excel, LibreOffice, etc.
 #****************************************************************/
@@ -37,9 +38,17 @@ my $Path = `pwd`;
 chomp($Path);
 
 # Nombre del ejecutable a probar (cambiar según el programa)
-# Opciones: mmClasicaFork, mmClasicaPosix, mmClasicaOpenMP, mmFilasOpenMP
+# Opciones: mmClasicaFork, mmClasicaPosix, mmClasicaOpenMP, mmFilasOpenMP,
+#           mmRecursivaOpenMP
 my $Nombre_Ejecutable = "mmClasicaFork"; # <-- CAMBIAR POR EL NOMBRE DEL EJECUTABLE A PROBAR
 
+# Núcleo denso de mmClasicaFork y mmClasicaPosix (vacío = clasica)
+# Opciones: "", "trans", "recursiva"
+my $Nucleo = "";
+
+# Nombre base de los archivos de resultados (incluye el núcleo elegido)
+my $Nombre_Salida = $Nucleo ? "${Nombre_Ejecutable}_$Nucleo" : $Nombre_Ejecutable;
+
 # Tamaños de matrices a probar (dimensión NxN)
 # Recomendación: Valores potencia de 2 o múltiplos de 100
 # Ajustar según capacidad del sistema y tiempo disponible
@@ -96,6 +105,7 @@ print "="x60 . "\n\n";
 print "Configuración de la batería de experimentos:\n";
 print "-" x 60 . "\n";
 print "Ejecutable       : $Nombre_Ejecutable\n";
+print "Núcleo           : " . ($Nucleo ? $Nucleo : "clasica") . "\n";
 print "Tamaños matriz   : " . join(", ", @Size_Matriz) . "\n";
 print "Número de hilos  : " . join(", ", @Num_Hilos) . "\n";
 print "Repeticiones     : $Repeticiones por configuración\n";
@@ -131,7 +141,7 @@ foreach my $size (@Size_Matriz) {
         
         # Construcción del nombre del archivo de salida
         # Formato: ejecutable-SIZE-Hilos-NUM.dat
-        my $archivo_salida = "$dir_resultados/$Nombre_Ejecutable-$size-Hilos-$hilo.dat";
+        my $archivo_salida = "$dir_resultados/$Nombre_Salida-$size-Hilos-$hilo.dat";
         
         # Mostrar progreso de la configuración actual
         my $progreso = sprintf("%.1f", ($contador_config / $total_configuraciones) * 100);
@@ -146,7 +156,7 @@ foreach my $size (@Size_Matriz) {
             
             # Comando de ejecución del programa
             # El operador >> redirige la salida (tiempo) al archivo .dat
-            my $comando = "$Path/$Nombre_Ejecutable $size $hilo >> $archivo_salida 2>&1";
+            my $comando = "$Path/$Nombre_Ejecutable $size $hilo $Nucleo >> $archivo_salida 2>&1";
             
             # Ejecutar el comando
             my $resultado = system($comando);
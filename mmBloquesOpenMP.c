@@ -0,0 +1,155 @@
+/*#######################################################################################
+#* Pontificia Universidad Javeriana
+#* Fecha: Noviembre 2025
+#* Autores: Juan David Garzon Ballen
+#*          Juan Pablo Sanchez
+#* Materia: Sistemas Operativos
+#* Tema: Taller de Evaluación de Rendimiento
+#* Programa: Multiplicación de Matrices - Layout por bloques (tiled/Morton) con OpenMP
+#* Descripción: Programa principal que convierte A y B una sola vez a un layout
+#*              por bloques (bloques ordenados por filas o en orden Z de Morton)
+#*              y luego multiplica directamente en ese layout con
+#*              multiMatrixBloques(). Cada producto de bloques usa tres bloques
+#*              contiguos en memoria, sin transponer B en cada multiplicación.
+#*              Con varias repeticiones, los operandos permanecen en el layout
+#*              por bloques, como ocurriría en un lote de multiplicaciones.
+#* Versión: Paralelismo con OpenMP - Layout por Bloques
+######################################################################################*/
+
+#include "mmCommon.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <omp.h>
+
+/**
+ * multiMatrixBloquesOpenMP - Multiplicación por bloques con OpenMP
+ * @mA: Matriz A en layout por bloques
+ * @mB: Matriz B en el mismo layout
+ * @mC: Matriz resultado C en el mismo layout
+ * @layout: LAYOUT_BLOQUES o LAYOUT_MORTON
+ * @D: Dimensión de las matrices cuadradas (D x D)
+ * @tb: Lado de bloque
+ *
+ * Reparte las filas de bloques entre hilos; cada hilo escribe bloques
+ * de C disjuntos, por lo que no hay condiciones de carrera.
+ */
+void multiMatrixBloquesOpenMP(double *mA, double *mB, double *mC, LayoutMatriz layout, int D, int tb) {
+    int nbt = (D + tb - 1) / tb;
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int bi = 0; bi < nbt; bi++) {
+        multiMatrixBloques(mA, mB, mC, layout, D, tb, bi, bi + 1);
+    }
+}
+
+/**
+ * main - Programa principal para multiplicación en layout por bloques
+ * @argc: Cantidad de argumentos de línea de comandos
+ * @argv: Vector de argumentos [programa, tamaño_matriz, num_hilos,
+ *        layout, repeticiones, tamaño_bloque]
+ *
+ * Algoritmo:
+ * 1. Valida argumentos de entrada
+ * 2. Asigna e inicializa A y B por filas
+ * 3. Convierte A y B al layout por bloques (una sola vez, medido aparte)
+ * 4. Multiplica en el layout por bloques las veces indicadas
+ * 5. Mide tiempo de ejecución y verifica correctitud (convirtiendo C a filas)
+ * 6. Libera memoria
+ *
+ * @return: 0 si éxito, 1 si error
+ */
+int main(int argc, char *argv[]) {
+    /* Validación de argumentos */
+    if (argc < 3) {
+        printf("\n \t\tUse: $./mmBloquesOpenMP SIZE Hilos [Layout] [Repeticiones] [Bloque]\n");
+        printf("\t\tSIZE: Dimensión de la matriz cuadrada (NxN)\n");
+        printf("\t\tHilos: Número de hilos OpenMP paralelos\n");
+        printf("\t\tLayout: bloques (defecto) o morton\n");
+        printf("\t\tRepeticiones: Multiplicaciones con los mismos operandos (defecto 1)\n");
+        printf("\t\tBloque: Lado de cada bloque (defecto 64)\n\n");
+        exit(0);
+    }
+
+    int N = atoi(argv[1]);                          // Dimensión de la matriz
+    int TH = atoi(argv[2]);                         // Número de hilos OpenMP
+    LayoutMatriz layout = (argc > 3 && strcmp(argv[3], "morton") == 0) ? LAYOUT_MORTON : LAYOUT_BLOQUES;
+    int reps = (argc > 4) ? atoi(argv[4]) : 1;      // Multiplicaciones seguidas
+    int tb = (argc > 5) ? atoi(argv[5]) : 64;       // Lado de bloque
+
+    if (argc > 3 && strcmp(argv[3], "morton") != 0 && strcmp(argv[3], "bloques") != 0) {
+        fprintf(stderr, "Error: Layout no reconocido: %s\n", argv[3]);
+        exit(1);
+    }
+    if (N <= 0 || TH <= 0 || reps <= 0 || tb <= 0) {
+        fprintf(stderr, "Error: Todos los argumentos numéricos deben ser positivos\n");
+        exit(1);
+    }
+
+    /* Matrices por filas (entrada y verificación) y por bloques (cómputo) */
+    long tamBloques = tamanoLayout(layout, N, tb);
+    double *matrixA = (double *)calloc(N * N, sizeof(double));
+    double *matrixB = (double *)calloc(N * N, sizeof(double));
+    double *matrixC = (double *)calloc(N * N, sizeof(double));
+    double *bloqA = (double *)calloc(tamBloques, sizeof(double));
+    double *bloqB = (double *)calloc(tamBloques, sizeof(double));
+    double *bloqC = (double *)calloc(tamBloques, sizeof(double));
+
+    if (!matrixA || !matrixB || !matrixC || !bloqA || !bloqB || !bloqC) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para matrices\n");
+        exit(1);
+    }
+
+    /* Configuración de OpenMP */
+    srand(time(NULL));
+    omp_set_num_threads(TH);
+
+    /* Inicialización de matrices con valores aleatorios */
+    iniMatrix(matrixA, matrixB, N);
+    impMatrix(matrixA, N);
+    impMatrix(matrixB, N);
+
+    /* Conversión única al layout por bloques */
+    double t0 = tiempoActual();
+    convertirLayout(matrixA, LAYOUT_FILAS, bloqA, layout, N, tb);
+    convertirLayout(matrixB, LAYOUT_FILAS, bloqB, layout, N, tb);
+    double tConversion = tiempoActual() - t0;
+
+    /* Medición de tiempo de las multiplicaciones en el layout por bloques */
+    InicioEnergia();
+    InicioMuestra();
+    t0 = tiempoActual();
+    for (int r = 0; r < reps; r++) {
+        multiMatrixBloquesOpenMP(bloqA, bloqB, bloqC, layout, N, tb);
+    }
+    double tMulti = tiempoActual() - t0;
+    FinMuestra();
+    FinEnergia(2.0 * N * N * N * reps);
+
+    printf("Layout %s, bloque %d: conversión %.0f us, %.0f us por multiplicación (%d)\n",
+           layout == LAYOUT_MORTON ? "morton" : "bloques", tb, tConversion, tMulti / reps, reps);
+
+    /* Conversión del resultado a filas para imprimir y verificar */
+    convertirLayout(bloqC, layout, matrixC, LAYOUT_FILAS, N, tb);
+    impMatrix(matrixC, N);
+
+    /* Verificación de correctitud para matrices pequeñas */
+    if (N < 9) {
+        if (verificarMultiplicacion(matrixA, matrixB, matrixC, N)) {
+            printf("\n[OK] Verificación: Multiplicación correcta\n");
+        } else {
+            printf("\n[ERROR] Verificación: Multiplicación incorrecta\n");
+        }
+    }
+
+    /* Liberación de memoria */
+    free(matrixA);
+    free(matrixB);
+    free(matrixC);
+    free(bloqA);
+    free(bloqB);
+    free(bloqC);
+
+    return 0;
+}
@@ -0,0 +1,287 @@
+/*#######################################################################################
+#* Pontificia Universidad Javeriana
+#* Fecha: Noviembre 2025
+#* Autores: Juan David Garzon Ballen
+#*          Juan Pablo Sanchez
+#* Materia: Sistemas Operativos
+#* Tema: Taller de Evaluación de Rendimiento
+#* Programa: Cadena de productos de matrices con orden óptimo y epílogo fusionado
+#* Descripción: Programa principal que evalúa R = relu(A1 × A2 × ... × Ak + C + sesgo)
+#*              con multiCadena(): elige la parentización de menor costo por
+#*              programación dinámica, guarda los productos intermedios en una
+#*              arena reservada una sola vez y suma C, el sesgo y la ReLU al
+#*              escribir el último producto. Compara con la evaluación directa
+#*              de izquierda a derecha, con temporales propios y una pasada
+#*              aparte por cada operación del epílogo.
+#* Versión: Paralelismo con OpenMP - Cadena de Matrices
+######################################################################################*/
+
+#include "mmCommon.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#include <time.h>
+#include <omp.h>
+
+#define MAX_MATRICES 32
+
+/* Dimensión máxima de la cadena para verificar el resultado: con cadenas
+ * más grandes, los distintos órdenes de suma pueden diferir más que la
+ * tolerancia por redondeo */
+#define DIM_MAX_VERIFICACION 64
+
+/**
+ * iniRect - Inicializa una matriz con valores aleatorios entre -1.0 y 1.0
+ * @m: Matriz a inicializar
+ * @elementos: Número de elementos
+ *
+ * Con valores de ambos signos la ReLU del epílogo sí recorta resultados.
+ */
+void iniRect(double *m, long elementos) {
+    for (long i = 0; i < elementos; i++) {
+        m[i] = (double)rand() / RAND_MAX * 2.0 - 1.0;
+    }
+}
+
+/**
+ * multiRectOpenMP - Producto rectangular sin epílogo repartido entre hilos
+ * @mA: Matriz A de m x n
+ * @mB: Matriz B de n x p
+ * @mC: Matriz resultado C de m x p
+ * @m: Filas de A y de C
+ * @n: Columnas de A / filas de B
+ * @p: Columnas de B y de C
+ *
+ * Cada hilo reserva su propio búfer de fila, como los temporales propios
+ * del resto de la evaluación directa.
+ */
+void multiRectOpenMP(double *mA, double *mB, double *mC, int m, int n, int p) {
+    #pragma omp parallel
+    {
+        int idH = omp_get_thread_num();
+        int nH = omp_get_num_threads();
+        int filaI = (long)m * idH / nH;
+        int filaF = (long)m * (idH + 1) / nH;
+        double *acc = (double *)malloc(p * sizeof(double));
+        if (!acc) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para el búfer de fila\n");
+            exit(1);
+        }
+        multiMatrixRect(mA, mB, mC, m, n, p, NULL, filaI, filaF, acc);
+        free(acc);
+    }
+}
+
+/**
+ * cadenaDirecta - Evaluación de referencia, de izquierda a derecha
+ * @mats: Matrices de la cadena
+ * @dims: k+1 dimensiones de la cadena
+ * @k: Número de matrices
+ * @mC: Matriz C que se suma al producto (dims[0] x dims[k])
+ * @sesgo: Vector de dims[k] elementos sumado a cada fila
+ * @mR: Resultado
+ *
+ * Cada producto intermedio reserva su propio temporal, y C, el sesgo y la
+ * ReLU se aplican en pasadas separadas sobre el resultado completo, como
+ * al encadenar ejecuciones independientes.
+ */
+void cadenaDirecta(double **mats, const int *dims, int k, double *mC, double *sesgo, double *mR) {
+    long elementos = (long)dims[0] * dims[k];
+    double *actual = mats[0];
+
+    for (int s = 1; s < k; s++) {
+        double *siguiente = (s == k - 1) ? mR : (double *)malloc((long)dims[0] * dims[s + 1] * sizeof(double));
+        if (!siguiente) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para temporales\n");
+            exit(1);
+        }
+        multiRectOpenMP(actual, mats[s], siguiente, dims[0], dims[s], dims[s + 1]);
+        if (actual != mats[0]) free(actual);
+        actual = siguiente;
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (long e = 0; e < elementos; e++) mR[e] += mC[e];
+    #pragma omp parallel for schedule(static)
+    for (long e = 0; e < elementos; e++) mR[e] += sesgo[e % dims[k]];
+    #pragma omp parallel for schedule(static)
+    for (long e = 0; e < elementos; e++) mR[e] = (mR[e] > 0.0) ? mR[e] : 0.0;
+}
+
+/**
+ * parsearDimensiones - Lee una lista de dimensiones "d0,d1,...,dk"
+ * @texto: Lista separada por comas
+ * @dims: Destino de hasta MAX_MATRICES+1 dimensiones
+ *
+ * La lista debe terminar en un número: una coma final, un texto sobrante
+ * o más de MAX_MATRICES+1 dimensiones la invalidan (no se trunca).
+ *
+ * @return: Número de matrices k, o 0 si la lista no es válida
+ */
+int parsearDimensiones(const char *texto, int *dims) {
+    int cuenta = 0;
+    const char *p = texto;
+
+    for (;;) {
+        char *fin;
+        long d = strtol(p, &fin, 10);
+        if (fin == p || d <= 0 || d > INT_MAX) return 0;
+        if (cuenta == MAX_MATRICES + 1) return 0;
+        dims[cuenta++] = (int)d;
+        if (*fin == '\0') break;
+        if (*fin != ',') return 0;
+        p = fin + 1;
+    }
+    return (cuenta >= 3) ? cuenta - 1 : 0;
+}
+
+/**
+ * main - Programa principal para la cadena de productos de matrices
+ * @argc: Cantidad de argumentos de línea de comandos
+ * @argv: Vector de argumentos [programa, tamaño_matriz, num_hilos, dimensiones]
+ *
+ * Algoritmo:
+ * 1. Valida argumentos; sin lista de dimensiones usa la cadena
+ *    N x N, N x N/8, N/8 x N, N x N/8
+ * 2. Calcula el orden óptimo y el tamaño de la arena de temporales
+ * 3. Inicializa las matrices, C y el sesgo con valores aleatorios
+ * 4. Mide la evaluación con multiCadena() (orden óptimo y epílogo fusionado)
+ * 5. Mide la evaluación directa de izquierda a derecha y compara (verifica
+ *    el resultado si ninguna dimensión supera DIM_MAX_VERIFICACION)
+ * 6. Libera memoria
+ *
+ * @return: 0 si éxito, 1 si error
+ */
+int main(int argc, char *argv[]) {
+    /* Validación de argumentos */
+    if (argc < 3) {
+        printf("\n \t\tUse: $./mmCadenaOpenMP SIZE Hilos [Dimensiones]\n");
+        printf("\t\tSIZE: Dimensión base de la cadena por defecto\n");
+        printf("\t\tHilos: Número de hilos OpenMP paralelos\n");
+        printf("\t\tDimensiones: d0,d1,...,dk; la matriz i es de d(i-1) x d(i)\n");
+        printf("\t\t             (defecto N,N,N/8,N,N/8)\n\n");
+        exit(0);
+    }
+
+    int N = atoi(argv[1]);     // Dimensión base
+    int TH = atoi(argv[2]);    // Número de hilos OpenMP
+    int dims[MAX_MATRICES + 1];
+    int k;
+
+    if (N <= 0 || TH <= 0) {
+        fprintf(stderr, "Error: Todos los argumentos deben ser positivos\n");
+        exit(1);
+    }
+    if (argc > 3) {
+        k = parsearDimensiones(argv[3], dims);
+        if (k == 0) {
+            fprintf(stderr, "Error: Dimensiones no válidas: %s (2 a %d matrices)\n", argv[3], MAX_MATRICES);
+            exit(1);
+        }
+    } else {
+        int chica = (N / 8 > 0) ? N / 8 : 1;
+        int defecto[] = {N, N, chica, N, chica};
+        k = 4;
+        memcpy(dims, defecto, sizeof(defecto));
+    }
+
+    /* Orden óptimo y memoria de temporales, antes de medir */
+    int *corte = (int *)malloc(k * k * sizeof(int));
+    if (!corte) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para el orden\n");
+        exit(1);
+    }
+    double costoOptimo = ordenCadena(dims, k, corte);
+    double costoDirecto = costoIzquierdaDerecha(dims, k);
+
+    /* Configuración de OpenMP antes de medir la arena: incluye un búfer de
+     * fila por hilo */
+    omp_set_num_threads(TH);
+
+    ArenaMatrices arena;
+    if (!iniArena(&arena, memoriaCadena(dims, corte, k))) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para la arena\n");
+        exit(1);
+    }
+
+    /* Asignación de matrices de la cadena, C, sesgo y resultados */
+    long elementosR = (long)dims[0] * dims[k];
+    double *mats[MAX_MATRICES];
+    for (int i = 0; i < k; i++) {
+        mats[i] = (double *)malloc((long)dims[i] * dims[i + 1] * sizeof(double));
+        if (!mats[i]) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para matrices\n");
+            exit(1);
+        }
+    }
+    double *matrixC = (double *)malloc(elementosR * sizeof(double));
+    double *sesgo = (double *)malloc(dims[k] * sizeof(double));
+    double *matrixR = (double *)malloc(elementosR * sizeof(double));
+    double *matrixRef = (double *)malloc(elementosR * sizeof(double));
+
+    if (!matrixC || !sesgo || !matrixR || !matrixRef) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para matrices\n");
+        exit(1);
+    }
+
+    /* Generador aleatorio (los hilos ya se fijaron al reservar la arena) */
+    srand(time(NULL));
+
+    /* Inicialización con valores aleatorios */
+    for (int i = 0; i < k; i++) iniRect(mats[i], (long)dims[i] * dims[i + 1]);
+    iniRect(matrixC, elementosR);
+    iniRect(sesgo, dims[k]);
+
+    printf("Orden óptimo: ");
+    imprimirOrdenCadena(corte, k, 0, k - 1);
+    printf("\nMultiplicaciones: %.3e óptimo vs %.3e de izquierda a derecha (%.2fx)\n",
+           costoOptimo, costoDirecto, costoDirecto / costoOptimo);
+    printf("Arena de temporales: %.1f KB\n", arena.capacidad * sizeof(double) / 1024.0);
+
+    /* R = relu(cadena + C + sesgo): beta = 1 lee C desde R */
+    Epilogo ep = {1.0, 1.0, sesgo, OPERACION_RELU};
+    memcpy(matrixR, matrixC, elementosR * sizeof(double));
+
+    /* Medición de la evaluación con orden óptimo y epílogo fusionado */
+    InicioEnergia();
+    InicioMuestra();
+    multiCadena(mats, dims, k, corte, matrixR, &ep, &arena);
+    FinMuestra();
+    FinEnergia(2.0 * costoOptimo);
+
+    /* Evaluación directa para comparar tiempo y resultado */
+    double inicio = tiempoActual();
+    cadenaDirecta(mats, dims, k, matrixC, sesgo, matrixRef);
+    printf("Izquierda a derecha sin fusión: %.0f us\n", tiempoActual() - inicio);
+
+    /* Verificación de correctitud para cadenas pequeñas (según las
+     * dimensiones usadas, no según N) */
+    int dimMax = 0;
+    for (int i = 0; i <= k; i++) {
+        if (dims[i] > dimMax) dimMax = dims[i];
+    }
+    if (dimMax <= DIM_MAX_VERIFICACION) {
+        int correcta = 1;
+        for (long e = 0; e < elementosR; e++) {
+            if (fabs(matrixR[e] - matrixRef[e]) > 1e-6 * (1.0 + fabs(matrixRef[e]))) correcta = 0;
+        }
+        if (correcta) {
+            printf("\n[OK] Verificación: Multiplicación correcta\n");
+        } else {
+            printf("\n[ERROR] Verificación: Multiplicación incorrecta\n");
+        }
+    }
+
+    /* Liberación de memoria */
+    for (int i = 0; i < k; i++) free(mats[i]);
+    free(matrixC);
+    free(sesgo);
+    free(matrixR);
+    free(matrixRef);
+    free(corte);
+    liberarArena(&arena);
+
+    return 0;
+}
@@ -21,35 +21,57 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+/* Dimensión máxima verificada (el núcleo recursiva se divide a partir de 32) */
+#define N_MAX_VERIFICACION 128
+
 /**
  * main - Programa principal para multiplicación con Fork
  * @argc: Cantidad de argumentos de línea de comandos
- * @argv: Vector de argumentos [programa, tamaño_matriz, num_procesos]
+ * @argv: Vector de argumentos [programa, tamaño_matriz, num_procesos, estructura, núcleo]
  * 
  * Algoritmo:
- * 1. Valida argumentos de entrada
+ * 1. Valida argumentos de entrada (estructura y núcleo, en cualquier orden)
  * 2. Crea memoria compartida para las tres matrices (A, B, C)
- * 3. Inicializa matrices A y B con valores aleatorios
- * 4. Crea N procesos hijo mediante fork()
- * 5. Cada hijo calcula un rango de filas de la matriz resultado
- * 6. El padre espera a que todos los hijos terminen
- * 7. Mide tiempo de ejecución y verifica correctitud (matrices pequeñas)
- * 8. Libera memoria compartida
+ * 3. Inicializa matrices A y B (A con la estructura opcional pedida)
+ * 4. Mide la estructura de A y elige el núcleo (denso, CSR, triangular, banda);
+ *    con el núcleo trans calcula B^T antes de medir
+ * 5. Crea N procesos hijo mediante fork()
+ * 6. Cada hijo calcula un rango de filas de la matriz resultado
+ * 7. El padre espera a que todos los hijos terminen
+ * 8. Mide tiempo de ejecución y verifica correctitud (N <= 128)
+ * 9. Libera memoria compartida
  * 
  * @return: 0 si éxito, 1 si error
  */
 int main(int argc, char *argv[]) {
     /* Validación de argumentos */
     if (argc < 3) {
-        printf("\n \t\tUse: $./mmClasicaFork Size Procesos \n");
+        printf("\n \t\tUse: $./mmClasicaFork Size Procesos [Estructura] [Núcleo]\n");
         printf("\t\tSize: Dimensión de la matriz cuadrada (NxN)\n");
-        printf("\t\tProcesos: Número de procesos paralelos\n\n");
+        printf("\t\tProcesos: Número de procesos paralelos\n");
+        printf("\t\tEstructura: densa (defecto), tri, trisup, banda:W o densidad (0.05)\n");
+        printf("\t\tNúcleo: clasica (defecto), trans o recursiva; solo con A densa\n\n");
         exit(0);
     }
 
     int N = (int)atoi(argv[1]);        // Dimensión de la matriz
     int num_P = (int)atoi(argv[2]);    // Número de procesos
 
+    /* Estructura opcional de A (núcleos dispersos) y núcleo denso opcional */
+    EstructuraMatriz estructura = ESTRUCTURA_DENSA;
+    double parametro = 0.0;
+    NucleoDenso nucleo = NUCLEO_CLASICA;
+    for (int a = 3; a < argc; a++) {
+        if (!parsearNucleo(argv[a], &nucleo) && !parsearEstructura(argv[a], &estructura, &parametro)) {
+            fprintf(stderr, "Error: Estructura o núcleo no reconocido: %s\n", argv[a]);
+            exit(1);
+        }
+    }
+    if (nucleo != NUCLEO_CLASICA && estructura != ESTRUCTURA_DENSA) {
+        fprintf(stderr, "Error: El núcleo %s solo admite A densa\n", nombreNucleo(nucleo));
+        exit(1);
+    }
+
     /* Creación de memoria compartida para las matrices
      * MAP_SHARED: Compartida entre procesos padre e hijos
      * MAP_ANONYMOUS: No respaldada por archivo, solo en RAM */
@@ -67,14 +89,42 @@ int main(int argc, char *argv[]) {
 
     /* Inicialización de matrices con valores aleatorios */
     srand(time(0));
-    iniMatrix(matA, matB, N);
+    iniMatrixEstructurada(matA, matB, N, estructura, parametro);
     impMatrix(matA, N);
     impMatrix(matB, N);
 
+    /* Selección automática del núcleo según la estructura medida de A.
+     * Se hace antes de fork() para que los hijos hereden el plan (y el CSR) */
+    PlanEstructura plan;
+    if (!prepararPlan(matA, N, &plan)) {
+        fprintf(stderr, "Error: No se pudo preparar el plan de multiplicación\n");
+        exit(1);
+    }
+    if (N < 9) {
+        printf("\nNúcleo seleccionado: %s (densidad %.2f)\n",
+               (nucleo == NUCLEO_CLASICA) ? nombreEstructura(plan.tipo) : nombreNucleo(nucleo),
+               plan.densidad);
+    }
+
+    /* B^T para el núcleo trans, fuera de la medición como en mmFilasOpenMP */
+    double *matBT = NULL;
+    if (nucleo == NUCLEO_TRANS) {
+        matBT = (double *)malloc(N * N * sizeof(double));
+        if (!matBT) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para B^T\n");
+            exit(1);
+        }
+        transposeMatrix(matB, matBT, N);
+    }
+
+    /* Vaciar stdout antes de fork() para que los hijos no repitan lo pendiente */
+    fflush(stdout);
+
     /* Cálculo de filas por proceso para distribución de carga */
     int rows_per_process = N / num_P;
 
-    /* Inicio de medición de tiempo */
+    /* Inicio de medición de tiempo y energía */
+    InicioEnergia();
     InicioMuestra();
 
     /* Creación de procesos hijos para paralelizar el cálculo */
@@ -87,7 +137,17 @@ int main(int argc, char *argv[]) {
             int end_row = (i == num_P - 1) ? N : start_row + rows_per_process;
 
             /* Cada hijo calcula su rango de filas asignado */
-            multiMatrix(matA, matB, matC, N, start_row, end_row);
+            switch (nucleo) {
+                case NUCLEO_TRANS:
+                    multiMatrixTransFilas(matA, matBT, matC, N, start_row, end_row);
+                    break;
+                case NUCLEO_RECURSIVA:
+                    multiMatrixRecursiva(matA, matB, matC, N, start_row, end_row);
+                    break;
+                default:
+                    multiMatrixPlan(&plan, matA, matB, matC, N, start_row, end_row);
+                    break;
+            }
 
             /* Debug: Información del proceso hijo (solo matrices pequeñas) */
             if (N < 9) {
@@ -112,22 +172,28 @@ int main(int argc, char *argv[]) {
         wait(NULL);  // Espera a cualquier hijo
     }
 
-    /* Fin de medición de tiempo */
+    /* Fin de medición de tiempo y energía (incluye a los procesos hijos) */
     FinMuestra();
+    FinEnergia(flopsPlan(&plan, N));   // operaciones del núcleo elegido, no las densas
 
     /* Impresión del resultado (solo matrices pequeñas) */
     impMatrix(matC, N);
 
-    /* Verificación de correctitud para matrices pequeñas */
-    if (N < 9) {
+    /* Verificación de correctitud: se imprime para matrices pequeñas; hasta
+     * N_MAX_VERIFICACION (p. ej. el núcleo recursiva con divisiones) solo
+     * se informa un error, para no alterar la salida de tiempos */
+    if (N <= N_MAX_VERIFICACION) {
         if (verificarMultiplicacion(matA, matB, matC, N)) {
-            printf("\n[OK] Verificación: Multiplicación correcta\n");
+            if (N < 9) printf("\n[OK] Verificación: Multiplicación correcta\n");
         } else {
             printf("\n[ERROR] Verificación: Multiplicación incorrecta\n");
+            return 1;
         }
     }
 
-    /* Liberación de memoria compartida */
+    /* Liberación de memoria compartida y del plan */
+    liberarPlan(&plan);
+    free(matBT);
     munmap(matA, N * N * sizeof(double));
     munmap(matB, N * N * sizeof(double));
     munmap(matC, N * N * sizeof(double));
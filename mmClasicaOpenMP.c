@@ -55,6 +55,25 @@ void multiMatrixOpenMP(double *mA, double *mB, double *mC, int D) {
     }
 }
 
+/**
+ * multiMatrixPlanOpenMP - Multiplicación con el núcleo del plan y OpenMP
+ * @plan: Plan creado con prepararPlan()
+ * @mA: Puntero a la matriz A (multiplicando)
+ * @mB: Puntero a la matriz B (multiplicador)
+ * @mC: Puntero a la matriz resultado C (producto)
+ * @D: Dimensión de las matrices cuadradas (D x D)
+ * 
+ * Camino para matrices con estructura (dispersa, triangular o banda).
+ * Cada iteración procesa una fila con multiMatrixPlan(). Se usa un reparto
+ * dinámico porque el trabajo por fila varía (p. ej. en triangulares).
+ */
+void multiMatrixPlanOpenMP(const PlanEstructura *plan, double *mA, double *mB, double *mC, int D) {
+    #pragma omp parallel for schedule(dynamic, 8)
+    for (int i = 0; i < D; i++) {
+        multiMatrixPlan(plan, mA, mB, mC, D, i, i + 1);
+    }
+}
+
 /**
  * main - Programa principal para multiplicación con OpenMP clásico
  * @argc: Cantidad de argumentos de línea de comandos
@@ -64,25 +83,35 @@ void multiMatrixOpenMP(double *mA, double *mB, double *mC, int D) {
  * 1. Valida argumentos de entrada
  * 2. Configura número de hilos OpenMP
  * 3. Asigna memoria para matrices A, B, C
- * 4. Inicializa matrices con valores aleatorios
- * 5. Ejecuta multiplicación con paralelización automática OpenMP
- * 6. Mide tiempo de ejecución y verifica correctitud
- * 7. Libera memoria
+ * 4. Inicializa matrices (A con la estructura opcional pedida)
+ * 5. Mide la estructura de A y elige el núcleo (denso, CSR, triangular, banda)
+ * 6. Ejecuta multiplicación con paralelización automática OpenMP
+ * 7. Mide tiempo de ejecución y verifica correctitud
+ * 8. Libera memoria
  * 
  * @return: 0 si éxito, 1 si error
  */
 int main(int argc, char *argv[]) {
     /* Validación de argumentos */
     if (argc < 3) {
-        printf("\n \t\tUse: $./mmClasicaOpenMP SIZE Hilos\n");
+        printf("\n \t\tUse: $./mmClasicaOpenMP SIZE Hilos [Estructura]\n");
         printf("\t\tSIZE: Dimensión de la matriz cuadrada (NxN)\n");
-        printf("\t\tHilos: Número de hilos OpenMP paralelos\n\n");
+        printf("\t\tHilos: Número de hilos OpenMP paralelos\n");
+        printf("\t\tEstructura: densa (defecto), tri, trisup, banda:W o densidad (0.05)\n\n");
         exit(0);
     }
 
     int N = atoi(argv[1]);     // Dimensión de la matriz
     int TH = atoi(argv[2]);    // Número de hilos OpenMP
 
+    /* Estructura opcional de A para probar los núcleos dispersos */
+    EstructuraMatriz estructura = ESTRUCTURA_DENSA;
+    double parametro = 0.0;
+    if (argc > 3 && !parsearEstructura(argv[3], &estructura, &parametro)) {
+        fprintf(stderr, "Error: Estructura no reconocida: %s\n", argv[3]);
+        exit(1);
+    }
+
     /* Asignación de memoria dinámica para matrices (inicializada a cero) */
     double *matrixA = (double *)calloc(N * N, sizeof(double));
     double *matrixB = (double *)calloc(N * N, sizeof(double));
@@ -98,14 +127,32 @@ int main(int argc, char *argv[]) {
     omp_set_num_threads(TH);  // Establece el número de hilos para OpenMP
 
     /* Inicialización de matrices con valores aleatorios */
-    iniMatrix(matrixA, matrixB, N);
+    iniMatrixEstructurada(matrixA, matrixB, N, estructura, parametro);
     impMatrix(matrixA, N);
     impMatrix(matrixB, N);
 
-    /* Medición de tiempo de ejecución de la multiplicación */
+    /* Selección automática del núcleo según la estructura medida de A */
+    PlanEstructura plan;
+    if (!prepararPlan(matrixA, N, &plan)) {
+        fprintf(stderr, "Error: No se pudo preparar el plan de multiplicación\n");
+        exit(1);
+    }
+    if (N < 9) {
+        printf("\nNúcleo seleccionado: %s (densidad %.2f)\n",
+               nombreEstructura(plan.tipo), plan.densidad);
+    }
+
+    /* Medición de tiempo de ejecución de la multiplicación
+     * Las matrices densas conservan el camino clásico sin cambios */
+    InicioEnergia();
     InicioMuestra();
-    multiMatrixOpenMP(matrixA, matrixB, matrixC, N);
+    if (plan.tipo == ESTRUCTURA_DENSA) {
+        multiMatrixOpenMP(matrixA, matrixB, matrixC, N);
+    } else {
+        multiMatrixPlanOpenMP(&plan, matrixA, matrixB, matrixC, N);
+    }
     FinMuestra();
+    FinEnergia(flopsPlan(&plan, N));   // operaciones del núcleo elegido, no las densas
 
     /* Impresión del resultado (solo matrices pequeñas) */
     impMatrix(matrixC, N);
@@ -120,6 +167,7 @@ int main(int argc, char *argv[]) {
     }
 
     /* Liberación de memoria */
+    liberarPlan(&plan);
     free(matrixA);
     free(matrixB);
     free(matrixC);
@@ -20,9 +20,15 @@
 #include <time.h>
 #include <pthread.h>
 
+/* Dimensión máxima verificada (el núcleo recursiva se divide a partir de 32) */
+#define N_MAX_VERIFICACION 128
+
 /* Variables globales compartidas entre todos los hilos */
 pthread_mutex_t MM_mutex;
 double *matrixA, *matrixB, *matrixC;
+double *matrixBT;   // B^T, solo con el núcleo trans
+PlanEstructura plan;
+NucleoDenso nucleo = NUCLEO_CLASICA;
 
 /**
  * struct parametros - Estructura para pasar parámetros a cada hilo
@@ -49,7 +55,7 @@ struct parametros {
  * Algoritmo:
  * 1. Extrae parámetros (ID hilo, total hilos, dimensión)
  * 2. Calcula rango de filas asignadas: [filaI, filaF)
- * 3. Ejecuta multiplicación clásica para ese rango
+ * 3. Ejecuta el núcleo pedido (o el elegido por el plan) para ese rango
  * 4. Sincroniza con mutex (sin operación crítica, solo para demostración)
  * 
  * @return: NULL (requerido por pthread)
@@ -61,12 +67,23 @@ void *multiMatrixThread(void *variables) {
     int nH = data->nH;      // Total de hilos
     int D = data->N;        // Dimensión de matriz
 
-    /* Cálculo del rango de filas que procesa este hilo */
-    int filaI = (D / nH) * idH;           // Fila inicial (inclusiva)
-    int filaF = (D / nH) * (idH + 1);     // Fila final (exclusiva)
+    /* Cálculo del rango de filas que procesa este hilo
+     * (el último toma el residuo, como en mmClasicaFork) */
+    int filaI = (D / nH) * idH;                                  // Fila inicial (inclusiva)
+    int filaF = (idH == nH - 1) ? D : (D / nH) * (idH + 1);     // Fila final (exclusiva)
 
     /* Llamada a la función de multiplicación de la biblioteca */
-    multiMatrix(matrixA, matrixB, matrixC, D, filaI, filaF);
+    switch (nucleo) {
+        case NUCLEO_TRANS:
+            multiMatrixTransFilas(matrixA, matrixBT, matrixC, D, filaI, filaF);
+            break;
+        case NUCLEO_RECURSIVA:
+            multiMatrixRecursiva(matrixA, matrixB, matrixC, D, filaI, filaF);
+            break;
+        default:
+            multiMatrixPlan(&plan, matrixA, matrixB, matrixC, D, filaI, filaF);
+            break;
+    }
 
     /* Sincronización con mutex (placeholder para futura coordinación) */
     pthread_mutex_lock(&MM_mutex);
@@ -79,32 +96,50 @@ void *multiMatrixThread(void *variables) {
 /**
  * main - Programa principal para multiplicación con Pthreads
  * @argc: Cantidad de argumentos de línea de comandos
- * @argv: Vector de argumentos [programa, tamaño_matriz, num_hilos]
+ * @argv: Vector de argumentos [programa, tamaño_matriz, num_hilos, estructura, núcleo]
  * 
  * Algoritmo:
- * 1. Valida argumentos de entrada
+ * 1. Valida argumentos de entrada (estructura y núcleo, en cualquier orden)
  * 2. Asigna memoria para matrices A, B, C
- * 3. Inicializa matrices con valores aleatorios
- * 4. Crea N hilos POSIX con pthread_create()
- * 5. Cada hilo calcula su rango de filas asignado
- * 6. Espera finalización de todos los hilos con pthread_join()
- * 7. Mide tiempo de ejecución y verifica correctitud
- * 8. Libera recursos (memoria, mutex, atributos)
+ * 3. Inicializa matrices (A con la estructura opcional pedida)
+ * 4. Mide la estructura de A y elige el núcleo (denso, CSR, triangular, banda);
+ *    con el núcleo trans calcula B^T antes de medir
+ * 5. Crea N hilos POSIX con pthread_create()
+ * 6. Cada hilo calcula su rango de filas asignado
+ * 7. Espera finalización de todos los hilos con pthread_join()
+ * 8. Mide tiempo de ejecución y verifica correctitud (N <= 128)
+ * 9. Libera recursos (memoria, mutex, atributos, plan)
  * 
  * @return: 0 si éxito, 1 si error
  */
 int main(int argc, char *argv[]) {
     /* Validación de argumentos */
     if (argc < 3) {
-        printf("\n \t\tUse: $./mmClasicaPosix tamMatriz numHilos\n");
+        printf("\n \t\tUse: $./mmClasicaPosix tamMatriz numHilos [estructura] [núcleo]\n");
         printf("\t\ttamMatriz: Dimensión de la matriz cuadrada (NxN)\n");
-        printf("\t\tnumHilos: Número de hilos POSIX paralelos\n\n");
+        printf("\t\tnumHilos: Número de hilos POSIX paralelos\n");
+        printf("\t\testructura: densa (defecto), tri, trisup, banda:W o densidad (0.05)\n");
+        printf("\t\tnúcleo: clasica (defecto), trans o recursiva; solo con A densa\n\n");
         exit(0);
     }
 
     int N = atoi(argv[1]);            // Dimensión de la matriz
     int n_threads = atoi(argv[2]);    // Número de hilos
 
+    /* Estructura opcional de A (núcleos dispersos) y núcleo denso opcional */
+    EstructuraMatriz estructura = ESTRUCTURA_DENSA;
+    double parametro = 0.0;
+    for (int a = 3; a < argc; a++) {
+        if (!parsearNucleo(argv[a], &nucleo) && !parsearEstructura(argv[a], &estructura, &parametro)) {
+            fprintf(stderr, "Error: Estructura o núcleo no reconocido: %s\n", argv[a]);
+            exit(1);
+        }
+    }
+    if (nucleo != NUCLEO_CLASICA && estructura != ESTRUCTURA_DENSA) {
+        fprintf(stderr, "Error: El núcleo %s solo admite A densa\n", nombreNucleo(nucleo));
+        exit(1);
+    }
+
     /* Arreglo de identificadores de hilos y atributos */
     pthread_t p[n_threads];
     pthread_attr_t atrMM;
@@ -121,11 +156,33 @@ int main(int argc, char *argv[]) {
 
     /* Inicialización de matrices con valores aleatorios */
     srand(time(NULL));
-    iniMatrix(matrixA, matrixB, N);
+    iniMatrixEstructurada(matrixA, matrixB, N, estructura, parametro);
     impMatrix(matrixA, N);
     impMatrix(matrixB, N);
 
-    /* Inicio de medición de tiempo */
+    /* Selección automática del núcleo según la estructura medida de A */
+    if (!prepararPlan(matrixA, N, &plan)) {
+        fprintf(stderr, "Error: No se pudo preparar el plan de multiplicación\n");
+        exit(1);
+    }
+    if (N < 9) {
+        printf("\nNúcleo seleccionado: %s (densidad %.2f)\n",
+               (nucleo == NUCLEO_CLASICA) ? nombreEstructura(plan.tipo) : nombreNucleo(nucleo),
+               plan.densidad);
+    }
+
+    /* B^T para el núcleo trans, fuera de la medición como en mmFilasOpenMP */
+    if (nucleo == NUCLEO_TRANS) {
+        matrixBT = (double *)malloc(N * N * sizeof(double));
+        if (!matrixBT) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para B^T\n");
+            exit(1);
+        }
+        transposeMatrix(matrixB, matrixBT, N);
+    }
+
+    /* Inicio de medición de tiempo y energía */
+    InicioEnergia();
     InicioMuestra();
 
     /* Inicialización de mutex y atributos de hilos */
@@ -158,24 +215,30 @@ int main(int argc, char *argv[]) {
         pthread_join(p[j], NULL);  // Bloquea hasta que el hilo j termine
     }
 
-    /* Fin de medición de tiempo */
+    /* Fin de medición de tiempo y energía */
     FinMuestra();
+    FinEnergia(flopsPlan(&plan, N));   // operaciones del núcleo elegido, no las densas
 
     /* Impresión del resultado (solo matrices pequeñas) */
     impMatrix(matrixC, N);
 
-    /* Verificación de correctitud para matrices pequeñas */
-    if (N < 9) {
+    /* Verificación de correctitud: se imprime para matrices pequeñas; hasta
+     * N_MAX_VERIFICACION (p. ej. el núcleo recursiva con divisiones) solo
+     * se informa un error, para no alterar la salida de tiempos */
+    if (N <= N_MAX_VERIFICACION) {
         if (verificarMultiplicacion(matrixA, matrixB, matrixC, N)) {
-            printf("\n[OK] Verificación: Multiplicación correcta\n");
+            if (N < 9) printf("\n[OK] Verificación: Multiplicación correcta\n");
         } else {
             printf("\n[ERROR] Verificación: Multiplicación incorrecta\n");
+            return 1;
         }
     }
 
     /* Liberación de recursos */
     pthread_attr_destroy(&atrMM);
     pthread_mutex_destroy(&MM_mutex);
+    liberarPlan(&plan);
+    free(matrixBT);
     free(matrixA);
     free(matrixB);
     free(matrixC);
@@ -16,11 +16,53 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
+#include <limits.h>
+#include <omp.h>
 #include <sys/time.h>
+#include <glob.h>
+#include <stdint.h>
+#include <sys/resource.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/* Umbrales de selección automática de núcleo (ver prepararPlan)
+ * - CSR compensa el acceso indirecto cuando quedan pocos no nulos
+ * - La banda compensa cuando recorre como máximo un cuarto de cada fila */
+#define UMBRAL_DENSIDAD_CSR 0.25
+#define FRACCION_MAX_BANDA 4
+
+/* Parámetros de la multiplicación recursiva (ver multiMatrixRecursiva)
+ * - Caso base: tres bloques de 32x32 doubles (24 KB) caben en L1
+ * - Por debajo de UMBRAL_TAREA operaciones no compensa crear tareas */
+#define BASE_RECURSIVA 32
+#define UMBRAL_TAREA (64L * 64L * 64L)
+
+/* Filas de C por unidad de reparto entre hilos en las cadenas de
+ * productos (ver evalCadena): amortiza el búfer de fila de cada grupo */
+#define FILAS_CADENA 16
+
+/* Parámetros del modo de poca memoria (ver multiMatrixPaneles)
+ * - Cada panel de B empaquetado ocupa como mucho BYTES_PANEL (caché L2)
+ * - Las filas de C se calculan en grupos de FILAS_PANEL antes de escribirse */
+#define BYTES_PANEL (256 * 1024)
+#define FILAS_PANEL 32
 
 /* Variables globales para medición de tiempo */
 static struct timeval inicio, fin;
 
+/* Estado de la medición de energía RAPL (ver InicioEnergia)
+ * - energiaActiva: -1 sin consultar, 0 desactivada, 1 activa
+ * - Por zona: ruta del contador, rango antes del desborde y lectura inicial */
+#define MAX_ZONAS_RAPL 16
+static int energiaActiva = -1;
+static int numZonasRapl = 0;
+static char contadorZona[MAX_ZONAS_RAPL][256];
+static double rangoZona[MAX_ZONAS_RAPL];
+static double energiaInicial[MAX_ZONAS_RAPL];
+static double tiempoInicialEnergia;
+
 /**
  * InicioMuestra - Registra el tiempo de inicio de ejecución
  */
@@ -42,6 +84,133 @@ void FinMuestra() {
     printf("%9.0f \n", tiempo);
 }
 
+/**
+ * tiempoActual - Devuelve el instante actual en microsegundos
+ * 
+ * No modifica las variables globales de InicioMuestra/FinMuestra,
+ * por lo que es segura para mediciones concurrentes entre hilos.
+ */
+double tiempoActual() {
+    struct timeval t;
+    gettimeofday(&t, (void *)0);
+    return (double)t.tv_sec * 1000000.0 + (double)t.tv_usec;
+}
+
+/**
+ * leerSysfs - Lee un valor numérico de un archivo de sysfs
+ * @ruta: Archivo a leer
+ * @valor: Destino del valor leído
+ *
+ * @return: 1 si se pudo leer, 0 si no existe o no hay permiso
+ */
+static int leerSysfs(const char *ruta, double *valor) {
+    FILE *f = fopen(ruta, "r");
+    if (!f) return 0;
+    int ok = (fscanf(f, "%lf", valor) == 1);
+    fclose(f);
+    return ok;
+}
+
+/**
+ * detectarZonasRapl - Busca los contadores RAPL de paquetes y DRAM
+ *
+ * Recorre /sys/class/powercap/intel-rapl:* (también lo usan los
+ * procesadores AMD recientes). Se suman las zonas "package-N" y "dram";
+ * las subzonas "core" y "uncore" ya están incluidas en su paquete.
+ *
+ * @return: Cantidad de zonas legibles encontradas
+ */
+static int detectarZonasRapl() {
+    glob_t zonas;
+    char ruta[256], nombre[64];
+
+    if (glob("/sys/class/powercap/intel-rapl:*", 0, NULL, &zonas) != 0) return 0;
+
+    for (size_t z = 0; z < zonas.gl_pathc && numZonasRapl < MAX_ZONAS_RAPL; z++) {
+        snprintf(ruta, sizeof(ruta), "%s/name", zonas.gl_pathv[z]);
+        FILE *f = fopen(ruta, "r");
+        if (!f) continue;
+        int leido = (fscanf(f, "%63s", nombre) == 1);
+        fclose(f);
+        if (!leido || (strncmp(nombre, "package", 7) != 0 && strcmp(nombre, "dram") != 0)) continue;
+
+        double valor, rango;
+        snprintf(ruta, sizeof(ruta), "%s/max_energy_range_uj", zonas.gl_pathv[z]);
+        if (!leerSysfs(ruta, &rango)) continue;
+        snprintf(ruta, sizeof(ruta), "%s/energy_uj", zonas.gl_pathv[z]);
+        if (!leerSysfs(ruta, &valor)) continue;
+
+        snprintf(contadorZona[numZonasRapl], sizeof(contadorZona[0]), "%s", ruta);
+        rangoZona[numZonasRapl] = rango;
+        numZonasRapl++;
+    }
+
+    globfree(&zonas);
+    return numZonasRapl;
+}
+
+/**
+ * InicioEnergia - Registra los contadores de energía RAPL al inicio
+ *
+ * La primera llamada decide si la medición está activa (MM_ENERGIA=1 y
+ * al menos una zona legible). Energy_uj suele requerir permisos de root
+ * desde Linux 5.10; sin ellos solo se avisa y el programa sigue igual.
+ */
+void InicioEnergia() {
+    if (energiaActiva < 0) {
+        const char *env = getenv("MM_ENERGIA");
+        energiaActiva = (env && strcmp(env, "1") == 0);
+        if (energiaActiva && detectarZonasRapl() == 0) {
+            fprintf(stderr, "Advertencia: RAPL no disponible, se omite la medición de energía\n");
+            energiaActiva = 0;
+        }
+    }
+    if (!energiaActiva) return;
+
+    for (int z = 0; z < numZonasRapl; z++) {
+        if (!leerSysfs(contadorZona[z], &energiaInicial[z])) energiaInicial[z] = 0.0;
+    }
+    tiempoInicialEnergia = tiempoActual();
+}
+
+/**
+ * FinEnergia - Calcula y muestra la energía consumida desde InicioEnergia
+ * @flops: Operaciones de punto flotante realizadas en el intervalo
+ *
+ * Los contadores son acumulados en microjoules y vuelven a cero al
+ * superar max_energy_range_uj; una diferencia negativa indica un desborde.
+ * La medición es de todo el paquete, no solo de este proceso.
+ */
+void FinEnergia(double flops) {
+    if (energiaActiva != 1) return;
+
+    double segundos = (tiempoActual() - tiempoInicialEnergia) / 1e6;
+    double microjoules = 0.0;
+
+    for (int z = 0; z < numZonasRapl; z++) {
+        double actual;
+        if (!leerSysfs(contadorZona[z], &actual)) continue;
+        double delta = actual - energiaInicial[z];
+        if (delta < 0) delta += rangoZona[z];
+        microjoules += delta;
+    }
+
+    double julios = microjoules / 1e6;
+    printf("ENERGIA julios=%.3f gflop_j=%.4f vatios=%.2f\n", julios,
+           julios > 0 ? flops / 1e9 / julios : 0.0, segundos > 0 ? julios / segundos : 0.0);
+}
+
+/**
+ * picoMemoriaMB - Pico de memoria residente (RSS) del proceso
+ *
+ * En Linux ru_maxrss se expresa en KB.
+ */
+double picoMemoriaMB() {
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_maxrss / 1024.0;
+}
+
 /**
  * iniMatrix - Inicializa dos matrices con valores aleatorios
  * @m1: Primera matriz (valores entre 1.0 y 5.0)
@@ -138,6 +307,104 @@ void multiMatrix(double *mA, double *mB, double *mC, int D, int filaI, int filaF
     }
 }
 
+/**
+ * multiMatrixAcum - Multiplicación con acumulación para un rango de filas
+ * @mA: Matriz A
+ * @mB: Matriz B
+ * @mC: Matriz C (acumulador, no se pone a cero)
+ * @D: Dimensión de las matrices
+ * @filaI: Fila inicial (inclusiva)
+ * @filaF: Fila final (exclusiva)
+ * 
+ * Implementa C[i,:] += A[i,k] × B[k,:] en orden i-k-j.
+ */
+void multiMatrixAcum(double *mA, double *mB, double *mC, int D, int filaI, int filaF) {
+    for (int i = filaI; i < filaF; i++) {
+        double *pC = mC + i * D;
+        for (int k = 0; k < D; k++) {
+            double a = mA[i * D + k];
+            double *pB = mB + k * D;  // Fila k de B
+            /* B y C no se solapan: se vectoriza sin la verificación de alias
+             * que el nivel -O2 de la biblioteca no se arriesga a generar */
+            #pragma omp simd
+            for (int j = 0; j < D; j++) {
+                pC[j] += a * pB[j];
+            }
+        }
+    }
+}
+
+/**
+ * multiRecursiva - Paso recursivo de C[m x n] += A[m x k] × B[k x n]
+ * @mA: Esquina superior izquierda del bloque de A
+ * @mB: Esquina superior izquierda del bloque de B
+ * @mC: Esquina superior izquierda del bloque de C
+ * @m: Filas del bloque de C (y de A)
+ * @n: Columnas del bloque de C (y de B)
+ * @k: Columnas de A / filas de B
+ * @ld: Distancia entre filas consecutivas (D de la matriz completa)
+ * 
+ * Dividir K produce dos productos que escriben el mismo bloque de C, por
+ * lo que se ejecutan en orden; dividir M o N produce mitades disjuntas.
+ */
+static void multiRecursiva(const double *mA, const double *mB, double *mC,
+                           int m, int n, int k, int ld) {
+    if (m <= BASE_RECURSIVA && n <= BASE_RECURSIVA && k <= BASE_RECURSIVA) {
+        for (int i = 0; i < m; i++) {
+            double *pC = mC + i * ld;
+            for (int p = 0; p < k; p++) {
+                double a = mA[i * ld + p];
+                const double *pB = mB + p * ld;
+                for (int j = 0; j < n; j++) {
+                    pC[j] += a * pB[j];
+                }
+            }
+        }
+        return;
+    }
+
+    int tareas = (long)m * n * k > UMBRAL_TAREA;
+
+    if (m >= n && m >= k) {
+        int m2 = m / 2;
+        #pragma omp task if(tareas)
+        multiRecursiva(mA, mB, mC, m2, n, k, ld);
+        #pragma omp task if(tareas)
+        multiRecursiva(mA + m2 * ld, mB, mC + m2 * ld, m - m2, n, k, ld);
+        #pragma omp taskwait
+    } else if (n >= k) {
+        int n2 = n / 2;
+        #pragma omp task if(tareas)
+        multiRecursiva(mA, mB, mC, m, n2, k, ld);
+        #pragma omp task if(tareas)
+        multiRecursiva(mA, mB + n2, mC + n2, m, n - n2, k, ld);
+        #pragma omp taskwait
+    } else {
+        int k2 = k / 2;
+        multiRecursiva(mA, mB, mC, m, n, k2, ld);
+        multiRecursiva(mA + k2, mB + k2 * ld, mC, m, n, k - k2, ld);
+    }
+}
+
+/**
+ * multiMatrixRecursiva - Multiplicación recursiva cache-oblivious por rango de filas
+ * @mA: Matriz A
+ * @mB: Matriz B
+ * @mC: Matriz resultado C
+ * @D: Dimensión de las matrices
+ * @filaI: Fila inicial (inclusiva)
+ * @filaF: Fila final (exclusiva)
+ * 
+ * Pone a cero las filas del rango y resuelve el subproblema de
+ * (filaF-filaI) x D x D con multiRecursiva().
+ */
+void multiMatrixRecursiva(double *mA, double *mB, double *mC, int D, int filaI, int filaF) {
+    for (int i = filaI * D; i < filaF * D; i++) mC[i] = 0.0;
+    if (filaF > filaI) {
+        multiRecursiva(mA + filaI * D, mB, mC + filaI * D, filaF - filaI, D, D, D);
+    }
+}
+
 /**
  * transposeMatrix - Crea la transpuesta de una matriz
  * @src: Matriz fuente (NO se modifica)
@@ -171,9 +438,22 @@ void transposeMatrix(double *src, double *dst, int D) {
  * Nota: Esta función NO usa OpenMP, debe paralelizarse externamente.
  */
 void multiMatrixTrans(double *mA, double *mBT, double *mC, int D) {
+    multiMatrixTransFilas(mA, mBT, mC, D, 0, D);
+}
+
+/**
+ * multiMatrixTransFilas - Multiplicación con B^T para un rango de filas
+ * @mA: Matriz A
+ * @mBT: Matriz B transpuesta (B^T)
+ * @mC: Matriz resultado C
+ * @D: Dimensión de las matrices
+ * @filaI: Fila inicial (inclusiva)
+ * @filaF: Fila final (exclusiva)
+ */
+void multiMatrixTransFilas(double *mA, double *mBT, double *mC, int D, int filaI, int filaF) {
     double Suma, *pA, *pB;
     
-    for (int i = 0; i < D; i++) {
+    for (int i = filaI; i < filaF; i++) {
         for (int j = 0; j < D; j++) {
             pA = mA + (i * D);    // Apunta a la fila i de A
             pB = mBT + (j * D);   // Apunta a la fila j de B^T (= columna j de B)
@@ -185,3 +465,1024 @@ void multiMatrixTrans(double *mA, double *mBT, double *mC, int D) {
         }
     }
 }
+
+/**
+ * parsearNucleo - Interpreta el argumento de núcleo de los programas
+ * @texto: "clasica", "trans" o "recursiva"
+ * @nucleo: Núcleo solicitado (salida)
+ * 
+ * @return: 1 si el texto es válido, 0 en caso contrario
+ */
+int parsearNucleo(const char *texto, NucleoDenso *nucleo) {
+    for (int n = NUCLEO_CLASICA; n <= NUCLEO_RECURSIVA; n++) {
+        if (strcmp(texto, nombreNucleo((NucleoDenso)n)) == 0) {
+            *nucleo = (NucleoDenso)n;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * nombreNucleo - Nombre de un núcleo denso
+ * @nucleo: Núcleo
+ * 
+ * @return: Cadena constante
+ */
+const char *nombreNucleo(NucleoDenso nucleo) {
+    switch (nucleo) {
+        case NUCLEO_TRANS:     return "trans";
+        case NUCLEO_RECURSIVA: return "recursiva";
+        default:               return "clasica";
+    }
+}
+
+/**
+ * parsearEstructura - Interpreta el argumento de estructura de los programas
+ * @texto: "densa", "tri", "trisup", "banda:W" o una densidad numérica
+ * @tipo: Estructura solicitada (salida)
+ * @parametro: Densidad o semiancho de banda (salida)
+ * 
+ * @return: 1 si el texto es válido, 0 en caso contrario
+ */
+int parsearEstructura(const char *texto, EstructuraMatriz *tipo, double *parametro) {
+    char *fin;
+
+    *parametro = 0.0;
+    if (strcmp(texto, "densa") == 0) {
+        *tipo = ESTRUCTURA_DENSA;
+    } else if (strcmp(texto, "tri") == 0) {
+        *tipo = ESTRUCTURA_TRI_INF;
+    } else if (strcmp(texto, "trisup") == 0) {
+        *tipo = ESTRUCTURA_TRI_SUP;
+    } else if (strncmp(texto, "banda:", 6) == 0) {
+        /* Semiancho entero: al menos un dígito, sin decimales ni signo negativo */
+        long w = strtol(texto + 6, &fin, 10);
+        if (fin == texto + 6 || *fin != '\0' || w < 0 || w > INT_MAX) return 0;
+        *tipo = ESTRUCTURA_BANDA;
+        *parametro = (double)w;
+    } else {
+        *parametro = strtod(texto, &fin);
+        /* Escrito así también rechaza NaN, que no cumple ninguna comparación */
+        if (fin == texto || *fin != '\0' || !(*parametro >= 0.0 && *parametro <= 1.0)) return 0;
+        *tipo = (*parametro < 1.0) ? ESTRUCTURA_DISPERSA : ESTRUCTURA_DENSA;
+    }
+    return 1;
+}
+
+/**
+ * iniMatrixEstructurada - Inicializa A con la estructura pedida y B densa
+ * @m1: Matriz A
+ * @m2: Matriz B
+ * @D: Dimensión de las matrices
+ * @tipo: Estructura de A
+ * @parametro: Densidad (dispersa) o semiancho de banda (banda)
+ * 
+ * Los elementos que se conservan en A mantienen el rango de iniMatrix().
+ */
+void iniMatrixEstructurada(double *m1, double *m2, int D, EstructuraMatriz tipo, double parametro) {
+    iniMatrix(m1, m2, D);
+
+    for (int i = 0; i < D; i++) {
+        for (int k = 0; k < D; k++) {
+            int anular = 0;
+            switch (tipo) {
+                case ESTRUCTURA_DISPERSA:
+                    anular = ((double)rand() / RAND_MAX) >= parametro;
+                    break;
+                case ESTRUCTURA_TRI_INF:
+                    anular = k > i;
+                    break;
+                case ESTRUCTURA_TRI_SUP:
+                    anular = k < i;
+                    break;
+                case ESTRUCTURA_BANDA:
+                    anular = abs(i - k) > (int)parametro;
+                    break;
+                default:
+                    break;
+            }
+            if (anular) m1[i * D + k] = 0.0;
+        }
+    }
+}
+
+/**
+ * prepararPlan - Mide la estructura de A y elige el núcleo de multiplicación
+ * @mA: Matriz A
+ * @D: Dimensión de la matriz
+ * @plan: Plan resultante
+ * 
+ * Solo se construye el CSR cuando se elige el camino disperso, de modo que
+ * las matrices densas no pagan memoria extra.
+ * 
+ * @return: 1 si éxito, 0 si falla la reserva de memoria
+ */
+int prepararPlan(double *mA, int D, PlanEstructura *plan) {
+    long nnz = 0;
+    int ancho = 0, hayInferior = 0, haySuperior = 0;
+
+    memset(plan, 0, sizeof(*plan));
+
+    for (int i = 0; i < D; i++) {
+        for (int k = 0; k < D; k++) {
+            if (mA[i * D + k] != 0.0) {
+                nnz++;
+                if (abs(i - k) > ancho) ancho = abs(i - k);
+                if (k < i) hayInferior = 1;
+                if (k > i) haySuperior = 1;
+            }
+        }
+    }
+
+    plan->densidad = (D > 0) ? (double)nnz / ((double)D * D) : 0.0;
+    plan->ancho = ancho;
+
+    if ((2 * ancho + 1) * FRACCION_MAX_BANDA <= D) {
+        plan->tipo = ESTRUCTURA_BANDA;
+    } else if (!haySuperior) {
+        plan->tipo = ESTRUCTURA_TRI_INF;
+    } else if (!hayInferior) {
+        plan->tipo = ESTRUCTURA_TRI_SUP;
+    } else if (plan->densidad <= UMBRAL_DENSIDAD_CSR) {
+        plan->tipo = ESTRUCTURA_DISPERSA;
+    } else {
+        plan->tipo = ESTRUCTURA_DENSA;
+    }
+
+    if (plan->tipo != ESTRUCTURA_DISPERSA) return 1;
+
+    /* Conversión a CSR: una pasada para llenar filaPtr, colIdx y valores */
+    MatrizCSR *csr = &plan->csr;
+    csr->D = D;
+    csr->nnz = (int)nnz;
+    csr->filaPtr = (int *)malloc((D + 1) * sizeof(int));
+    csr->colIdx = (int *)malloc((nnz > 0 ? nnz : 1) * sizeof(int));
+    csr->valores = (double *)malloc((nnz > 0 ? nnz : 1) * sizeof(double));
+    if (!csr->filaPtr || !csr->colIdx || !csr->valores) {
+        liberarPlan(plan);
+        return 0;
+    }
+
+    int pos = 0;
+    for (int i = 0; i < D; i++) {
+        csr->filaPtr[i] = pos;
+        for (int k = 0; k < D; k++) {
+            if (mA[i * D + k] != 0.0) {
+                csr->colIdx[pos] = k;
+                csr->valores[pos] = mA[i * D + k];
+                pos++;
+            }
+        }
+    }
+    csr->filaPtr[D] = pos;
+    return 1;
+}
+
+/**
+ * liberarPlan - Libera la memoria asociada a un plan
+ * @plan: Plan creado con prepararPlan()
+ */
+void liberarPlan(PlanEstructura *plan) {
+    free(plan->csr.filaPtr);
+    free(plan->csr.colIdx);
+    free(plan->csr.valores);
+    memset(&plan->csr, 0, sizeof(plan->csr));
+}
+
+/**
+ * nombreEstructura - Nombre legible de una estructura
+ * @tipo: Estructura
+ */
+const char *nombreEstructura(EstructuraMatriz tipo) {
+    switch (tipo) {
+        case ESTRUCTURA_DISPERSA: return "dispersa (CSR)";
+        case ESTRUCTURA_TRI_INF:  return "triangular inferior";
+        case ESTRUCTURA_TRI_SUP:  return "triangular superior";
+        case ESTRUCTURA_BANDA:    return "banda";
+        default:                  return "densa";
+    }
+}
+
+/**
+ * multiMatrixCSR - Multiplicación CSR × densa para un rango de filas
+ * @A: Matriz A en CSR
+ * @mB: Matriz B
+ * @mC: Matriz resultado C
+ * @D: Dimensión de las matrices
+ * @filaI: Fila inicial (inclusiva)
+ * @filaF: Fila final (exclusiva)
+ * 
+ * Orden i-k-j: cada no nulo A[i,k] escala la fila k de B y la suma
+ * a la fila i de C, ambas recorridas secuencialmente.
+ */
+void multiMatrixCSR(const MatrizCSR *A, double *mB, double *mC, int D, int filaI, int filaF) {
+    for (int i = filaI; i < filaF; i++) {
+        double *pC = mC + i * D;
+        for (int j = 0; j < D; j++) pC[j] = 0.0;
+
+        for (int p = A->filaPtr[i]; p < A->filaPtr[i + 1]; p++) {
+            double a = A->valores[p];
+            double *pB = mB + A->colIdx[p] * D;  // Fila k de B
+            for (int j = 0; j < D; j++) {
+                pC[j] += a * pB[j];
+            }
+        }
+    }
+}
+
+/**
+ * multiMatrixTriangular - Multiplicación con A triangular para un rango de filas
+ * @mA: Matriz A triangular
+ * @mB: Matriz B
+ * @mC: Matriz resultado C
+ * @D: Dimensión de las matrices
+ * @inferior: 1 si A es triangular inferior, 0 si es superior
+ * @filaI: Fila inicial (inclusiva)
+ * @filaF: Fila final (exclusiva)
+ */
+void multiMatrixTriangular(double *mA, double *mB, double *mC, int D, int inferior,
+                           int filaI, int filaF) {
+    for (int i = filaI; i < filaF; i++) {
+        double *pC = mC + i * D;
+        int kI = inferior ? 0 : i;
+        int kF = inferior ? i + 1 : D;
+        for (int j = 0; j < D; j++) pC[j] = 0.0;
+
+        for (int k = kI; k < kF; k++) {
+            double a = mA[i * D + k];
+            double *pB = mB + k * D;
+            for (int j = 0; j < D; j++) {
+                pC[j] += a * pB[j];
+            }
+        }
+    }
+}
+
+/**
+ * multiMatrixBanda - Multiplicación con A de banda para un rango de filas
+ * @mA: Matriz A de banda
+ * @mB: Matriz B
+ * @mC: Matriz resultado C
+ * @D: Dimensión de las matrices
+ * @ancho: Semiancho de banda
+ * @filaI: Fila inicial (inclusiva)
+ * @filaF: Fila final (exclusiva)
+ */
+void multiMatrixBanda(double *mA, double *mB, double *mC, int D, int ancho,
+                      int filaI, int filaF) {
+    for (int i = filaI; i < filaF; i++) {
+        double *pC = mC + i * D;
+        int kI = (i - ancho > 0) ? i - ancho : 0;
+        int kF = (i + ancho + 1 < D) ? i + ancho + 1 : D;
+        for (int j = 0; j < D; j++) pC[j] = 0.0;
+
+        for (int k = kI; k < kF; k++) {
+            double a = mA[i * D + k];
+            double *pB = mB + k * D;
+            for (int j = 0; j < D; j++) {
+                pC[j] += a * pB[j];
+            }
+        }
+    }
+}
+
+/**
+ * multiMatrixPlan - Multiplica un rango de filas con el núcleo del plan
+ * @plan: Plan creado con prepararPlan()
+ * @mA: Matriz A densa
+ * @mB: Matriz B
+ * @mC: Matriz resultado C
+ * @D: Dimensión de las matrices
+ * @filaI: Fila inicial (inclusiva)
+ * @filaF: Fila final (exclusiva)
+ */
+void multiMatrixPlan(const PlanEstructura *plan, double *mA, double *mB, double *mC, int D,
+                     int filaI, int filaF) {
+    switch (plan->tipo) {
+        case ESTRUCTURA_DISPERSA:
+            multiMatrixCSR(&plan->csr, mB, mC, D, filaI, filaF);
+            break;
+        case ESTRUCTURA_TRI_INF:
+            multiMatrixTriangular(mA, mB, mC, D, 1, filaI, filaF);
+            break;
+        case ESTRUCTURA_TRI_SUP:
+            multiMatrixTriangular(mA, mB, mC, D, 0, filaI, filaF);
+            break;
+        case ESTRUCTURA_BANDA:
+            multiMatrixBanda(mA, mB, mC, D, plan->ancho, filaI, filaF);
+            break;
+        default:
+            multiMatrix(mA, mB, mC, D, filaI, filaF);
+            break;
+    }
+}
+
+/**
+ * flopsPlan - Operaciones de punto flotante del producto con el núcleo del plan
+ * @plan: Plan creado con prepararPlan()
+ * @D: Dimensión de las matrices
+ * 
+ * La banda de semiancho w tiene D·(2w+1) - w·(w+1) elementos (recortada
+ * en las esquinas); con w >= D-1 son los D² de la matriz completa.
+ */
+double flopsPlan(const PlanEstructura *plan, int D) {
+    double d = D;
+
+    switch (plan->tipo) {
+        case ESTRUCTURA_DISPERSA:
+            return 2.0 * plan->csr.nnz * d;
+        case ESTRUCTURA_TRI_INF:
+        case ESTRUCTURA_TRI_SUP:
+            return d * d * (d + 1.0);
+        case ESTRUCTURA_BANDA: {
+            double w = (plan->ancho < D - 1) ? plan->ancho : d - 1.0;
+            return 2.0 * d * (d * (2.0 * w + 1.0) - w * (w + 1.0));
+        }
+        default:
+            return 2.0 * d * d * d;
+    }
+}
+
+/* Generación de núcleos especializados para tamaños pequeños fijos.
+ * Con T constante en compilación, el compilador desenrolla por completo
+ * los bucles k y j y vectoriza la fila de C, eliminando el control de
+ * bucle y el cálculo de índices con D variable que dominan en 4x4..32x32.
+ * MM_PRAGMA permite expandir T dentro de la directiva de desenrollado. */
+#define MM_PRAGMA(x) _Pragma(#x)
+#define MM_DESENROLLAR(n) MM_PRAGMA(GCC unroll n)
+
+#define DEFINIR_MULTI_FIJA(T)                                                 \
+static void multiMatrixFija##T(const double *restrict mA,                     \
+                               const double *restrict mB,                     \
+                               double *restrict mC) {                         \
+    for (int i = 0; i < T; i++) {                                             \
+        double fila[T] = {0.0};                                               \
+        MM_DESENROLLAR(T)                                                     \
+        for (int k = 0; k < T; k++) {                                         \
+            double a = mA[i * T + k];                                         \
+            MM_DESENROLLAR(T)                                                 \
+            for (int j = 0; j < T; j++) {                                     \
+                fila[j] += a * mB[k * T + j];                                 \
+            }                                                                 \
+        }                                                                     \
+        MM_DESENROLLAR(T)                                                     \
+        for (int j = 0; j < T; j++) {                                         \
+            mC[i * T + j] = fila[j];                                          \
+        }                                                                     \
+    }                                                                         \
+}
+
+DEFINIR_MULTI_FIJA(4)
+DEFINIR_MULTI_FIJA(8)
+DEFINIR_MULTI_FIJA(16)
+DEFINIR_MULTI_FIJA(32)
+
+/**
+ * seleccionarMultiFija - Devuelve el núcleo especializado para D, o NULL
+ * @D: Dimensión de las matrices
+ */
+static void (*seleccionarMultiFija(int D))(const double *, const double *, double *) {
+    switch (D) {
+        case 4:  return multiMatrixFija4;
+        case 8:  return multiMatrixFija8;
+        case 16: return multiMatrixFija16;
+        case 32: return multiMatrixFija32;
+        default: return NULL;
+    }
+}
+
+/**
+ * tamanoFijoSoportado - Indica si existe un núcleo especializado para D
+ * @D: Dimensión de las matrices
+ */
+int tamanoFijoSoportado(int D) {
+    return seleccionarMultiFija(D) != NULL;
+}
+
+/**
+ * multiMatrixLote - Multiplica un rango de un lote de matrices pequeñas
+ * @mA: Lote de matrices A
+ * @mB: Lote de matrices B
+ * @mC: Lote de matrices resultado C
+ * @D: Dimensión de cada matriz
+ * @loteI: Primera matriz del rango (inclusiva)
+ * @loteF: Última matriz del rango (exclusiva)
+ * 
+ * Para tamaños sin núcleo especializado usa un producto i-k-j genérico,
+ * que recorre B y C por filas igual que los núcleos especializados.
+ */
+void multiMatrixLote(double *mA, double *mB, double *mC, int D, int loteI, int loteF) {
+    void (*fija)(const double *, const double *, double *) = seleccionarMultiFija(D);
+    long tam = (long)D * D;
+
+    for (int b = loteI; b < loteF; b++) {
+        double *pA = mA + b * tam;
+        double *pB = mB + b * tam;
+        double *pC = mC + b * tam;
+
+        if (fija) {
+            fija(pA, pB, pC);
+            continue;
+        }
+        for (int i = 0; i < D; i++) {
+            for (int j = 0; j < D; j++) pC[i * D + j] = 0.0;
+            for (int k = 0; k < D; k++) {
+                double a = pA[i * D + k];
+                for (int j = 0; j < D; j++) {
+                    pC[i * D + j] += a * pB[k * D + j];
+                }
+            }
+        }
+    }
+}
+
+/**
+ * mallaBloques - Lado de la malla de bloques almacenada para un layout
+ * @layout: LAYOUT_BLOQUES o LAYOUT_MORTON
+ * @D: Dimensión de la matriz
+ * @tb: Lado de bloque
+ * 
+ * Morton necesita una malla de lado potencia de 2 para que el orden Z
+ * sea denso; el resto de bloques de relleno quedan en cero.
+ */
+static int mallaBloques(LayoutMatriz layout, int D, int tb) {
+    int nbt = (D + tb - 1) / tb;
+    if (layout != LAYOUT_MORTON) return nbt;
+
+    int p = 1;
+    while (p < nbt) p <<= 1;
+    return p;
+}
+
+/**
+ * desplazamientoBloque - Posición del primer elemento del bloque (bi,bj)
+ * @layout: LAYOUT_BLOQUES o LAYOUT_MORTON
+ * @bi: Fila de bloque
+ * @bj: Columna de bloque
+ * @malla: Lado de la malla de bloques (mallaBloques)
+ * @tb: Lado de bloque
+ */
+static long desplazamientoBloque(LayoutMatriz layout, int bi, int bj, int malla, int tb) {
+    long orden;
+
+    if (layout == LAYOUT_MORTON) {
+        /* Entrelazado de bits: fila en posiciones impares, columna en pares */
+        orden = 0;
+        for (int b = 0; (1 << b) < malla; b++) {
+            orden |= (long)((bj >> b) & 1) << (2 * b);
+            orden |= (long)((bi >> b) & 1) << (2 * b + 1);
+        }
+    } else {
+        orden = (long)bi * malla + bj;
+    }
+    return orden * tb * tb;
+}
+
+/**
+ * tamanoLayout - Número de elementos que ocupa una matriz en un layout
+ * @layout: Disposición en memoria
+ * @D: Dimensión de la matriz
+ * @tb: Lado de bloque
+ */
+long tamanoLayout(LayoutMatriz layout, int D, int tb) {
+    if (layout == LAYOUT_FILAS || layout == LAYOUT_COLUMNAS) return (long)D * D;
+
+    long malla = mallaBloques(layout, D, tb);
+    return malla * malla * tb * tb;
+}
+
+/**
+ * indiceLayout - Posición del elemento (i,j) dentro de un layout
+ * @layout: Disposición en memoria
+ * @i: Fila
+ * @j: Columna
+ * @D: Dimensión de la matriz
+ * @tb: Lado de bloque
+ */
+long indiceLayout(LayoutMatriz layout, int i, int j, int D, int tb) {
+    switch (layout) {
+        case LAYOUT_COLUMNAS:
+            return (long)j * D + i;
+        case LAYOUT_BLOQUES:
+        case LAYOUT_MORTON:
+            return desplazamientoBloque(layout, i / tb, j / tb, mallaBloques(layout, D, tb), tb)
+                   + (i % tb) * tb + (j % tb);
+        default:
+            return (long)i * D + j;
+    }
+}
+
+/**
+ * convertirLayout - Copia una matriz de un layout a otro
+ * @src: Matriz fuente
+ * @lsrc: Layout de la fuente
+ * @dst: Matriz destino
+ * @ldst: Layout del destino
+ * @D: Dimensión de la matriz
+ * @tb: Lado de bloque
+ * 
+ * Los layouts por bloques se recorren bloque a bloque: el desplazamiento
+ * de cada bloque se calcula una sola vez y sus filas se copian con
+ * memcpy(). Solo el paso por columnas se hace elemento a elemento, con
+ * índices directos. Cada hilo escribe zonas disjuntas del destino.
+ */
+void convertirLayout(double *src, LayoutMatriz lsrc, double *dst, LayoutMatriz ldst, int D, int tb) {
+    int srcBloques = (lsrc == LAYOUT_BLOQUES || lsrc == LAYOUT_MORTON);
+    int nbt = (D + tb - 1) / tb;
+
+    if (ldst == LAYOUT_BLOQUES || ldst == LAYOUT_MORTON) {
+        int malla = mallaBloques(ldst, D, tb);
+        int mallaSrc = srcBloques ? mallaBloques(lsrc, D, tb) : 0;
+        long tam = (long)tb * tb;
+
+        #pragma omp parallel for collapse(2) schedule(static)
+        for (int bi = 0; bi < malla; bi++) {
+            for (int bj = 0; bj < malla; bj++) {
+                double *bloque = dst + desplazamientoBloque(ldst, bi, bj, malla, tb);
+
+                /* Bloques de relleno de Morton, fuera de la matriz */
+                if (bi >= nbt || bj >= nbt) {
+                    memset(bloque, 0, tam * sizeof(double));
+                    continue;
+                }
+                /* Mismo lado de bloque: solo cambia la posición del bloque */
+                if (srcBloques) {
+                    memcpy(bloque, src + desplazamientoBloque(lsrc, bi, bj, mallaSrc, tb), tam * sizeof(double));
+                    continue;
+                }
+
+                int filas = (D - bi * tb < tb) ? D - bi * tb : tb;
+                int cols = (D - bj * tb < tb) ? D - bj * tb : tb;
+                memset(bloque, 0, tam * sizeof(double));
+                for (int ii = 0; ii < filas; ii++) {
+                    int i = bi * tb + ii;
+                    if (lsrc == LAYOUT_COLUMNAS) {
+                        for (int jj = 0; jj < cols; jj++) {
+                            bloque[ii * tb + jj] = src[(long)(bj * tb + jj) * D + i];
+                        }
+                    } else {
+                        memcpy(bloque + ii * tb, src + (long)i * D + bj * tb, cols * sizeof(double));
+                    }
+                }
+            }
+        }
+    } else if (srcBloques) {
+        int mallaSrc = mallaBloques(lsrc, D, tb);
+
+        #pragma omp parallel for collapse(2) schedule(static)
+        for (int bi = 0; bi < nbt; bi++) {
+            for (int bj = 0; bj < nbt; bj++) {
+                double *bloque = src + desplazamientoBloque(lsrc, bi, bj, mallaSrc, tb);
+                int filas = (D - bi * tb < tb) ? D - bi * tb : tb;
+                int cols = (D - bj * tb < tb) ? D - bj * tb : tb;
+
+                for (int ii = 0; ii < filas; ii++) {
+                    int i = bi * tb + ii;
+                    if (ldst == LAYOUT_COLUMNAS) {
+                        for (int jj = 0; jj < cols; jj++) {
+                            dst[(long)(bj * tb + jj) * D + i] = bloque[ii * tb + jj];
+                        }
+                    } else {
+                        memcpy(dst + (long)i * D + bj * tb, bloque + ii * tb, cols * sizeof(double));
+                    }
+                }
+            }
+        }
+    } else if (lsrc == ldst) {
+        memcpy(dst, src, (long)D * D * sizeof(double));
+    } else {
+        /* Filas <-> columnas: transposición */
+        #pragma omp parallel for schedule(static)
+        for (int a = 0; a < D; a++) {
+            for (int b = 0; b < D; b++) {
+                dst[(long)a * D + b] = src[(long)b * D + a];
+            }
+        }
+    }
+}
+
+/**
+ * multiMatrixBloques - Multiplicación nativa en layout por bloques
+ * @mA: Matriz A por bloques
+ * @mB: Matriz B por bloques
+ * @mC: Matriz resultado C por bloques
+ * @layout: LAYOUT_BLOQUES o LAYOUT_MORTON
+ * @D: Dimensión de las matrices
+ * @tb: Lado de bloque
+ * @bloqueI: Fila de bloques inicial (inclusiva)
+ * @bloqueF: Fila de bloques final (exclusiva)
+ * 
+ * C(bi,bj) = suma(A(bi,bk) × B(bk,bj)) sobre los bloques con datos;
+ * los bloques de relleno de Morton fuera de ceil(D/tb) se omiten.
+ */
+void multiMatrixBloques(double *mA, double *mB, double *mC, LayoutMatriz layout, int D, int tb,
+                        int bloqueI, int bloqueF) {
+    int malla = mallaBloques(layout, D, tb);
+    int nbt = (D + tb - 1) / tb;
+    long tam = (long)tb * tb;
+
+    for (int bi = bloqueI; bi < bloqueF; bi++) {
+        for (int bj = 0; bj < nbt; bj++) {
+            double *bC = mC + desplazamientoBloque(layout, bi, bj, malla, tb);
+            for (long e = 0; e < tam; e++) bC[e] = 0.0;
+
+            for (int bk = 0; bk < nbt; bk++) {
+                multiMatrixAcum(mA + desplazamientoBloque(layout, bi, bk, malla, tb),
+                                mB + desplazamientoBloque(layout, bk, bj, malla, tb),
+                                bC, tb, 0, tb);
+            }
+        }
+    }
+}
+
+/**
+ * multiMatrixRect - Multiplicación rectangular con epílogo fusionado
+ * @mA: Matriz A de m x n
+ * @mB: Matriz B de n x p
+ * @mC: Matriz resultado C de m x p
+ * @m: Filas de A y de C
+ * @n: Columnas de A / filas de B
+ * @p: Columnas de B y de C
+ * @ep: Epílogo a aplicar, o NULL para C = A×B
+ * @filaI: Fila inicial del rango a procesar (inclusiva)
+ * @filaF: Fila final del rango a procesar (exclusiva)
+ * @acc: Búfer de fila de p elementos, propio del hilo que llama
+ * 
+ * La fila de A×B se acumula en un búfer que permanece en caché; C se
+ * toca una sola vez por elemento, ya con alfa, beta, sesgo y operación.
+ */
+void multiMatrixRect(const double *mA, const double *mB, double *mC, int m, int n, int p,
+                     const Epilogo *ep, int filaI, int filaF, double *acc) {
+    double alfa = ep ? ep->alfa : 1.0;
+    double beta = ep ? ep->beta : 0.0;
+    const double *sesgo = ep ? ep->sesgo : NULL;
+    OperacionElemento op = ep ? ep->op : OPERACION_NINGUNA;
+
+    for (int i = filaI; i < filaF; i++) {
+        const double *pA = mA + (long)i * n;
+        double *pC = mC + (long)i * p;
+
+        for (int j = 0; j < p; j++) acc[j] = 0.0;
+        for (int k = 0; k < n; k++) {
+            double a = pA[k];
+            const double *pB = mB + (long)k * p;  // Fila k de B
+            #pragma omp simd
+            for (int j = 0; j < p; j++) {
+                acc[j] += a * pB[j];
+            }
+        }
+
+        /* Epílogo fusionado: una sola escritura por elemento de C */
+        for (int j = 0; j < p; j++) {
+            double x = alfa * acc[j];
+            if (beta != 0.0) x += beta * pC[j];
+            if (sesgo) x += sesgo[j];
+            if (op == OPERACION_RELU) x = (x > 0.0) ? x : 0.0;
+            else if (op == OPERACION_TANH) x = tanh(x);
+            pC[j] = x;
+        }
+    }
+}
+
+/**
+ * ordenCadena - Parentización óptima de un producto de k matrices
+ * @dims: k+1 dimensiones; la matriz i es de dims[i] x dims[i+1]
+ * @k: Número de matrices de la cadena
+ * @corte: Matriz k x k con el punto de división de cada subproducto
+ * 
+ * costo[i][j] = min sobre s de costo[i][s] + costo[s+1][j] +
+ * dims[i]·dims[s+1]·dims[j+1], resuelto por longitud creciente.
+ */
+double ordenCadena(const int *dims, int k, int *corte) {
+    double *costo = (double *)calloc((long)k * k, sizeof(double));
+    if (!costo) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para el orden de la cadena\n");
+        exit(1);
+    }
+
+    for (int i = 0; i < k; i++) corte[i * k + i] = i;
+    for (int largo = 2; largo <= k; largo++) {
+        for (int i = 0; i + largo - 1 < k; i++) {
+            int j = i + largo - 1;
+            costo[i * k + j] = -1.0;
+            for (int s = i; s < j; s++) {
+                double c = costo[i * k + s] + costo[(s + 1) * k + j]
+                         + (double)dims[i] * dims[s + 1] * dims[j + 1];
+                if (costo[i * k + j] < 0.0 || c < costo[i * k + j]) {
+                    costo[i * k + j] = c;
+                    corte[i * k + j] = s;
+                }
+            }
+        }
+    }
+
+    double total = costo[k - 1];  // Subproducto 0..k-1
+    free(costo);
+    return total;
+}
+
+/**
+ * costoIzquierdaDerecha - Multiplicaciones escalares de ((A1 A2) A3)...
+ * @dims: k+1 dimensiones de la cadena
+ * @k: Número de matrices de la cadena
+ */
+double costoIzquierdaDerecha(const int *dims, int k) {
+    double total = 0.0;
+    for (int s = 1; s < k; s++) {
+        total += (double)dims[0] * dims[s] * dims[s + 1];
+    }
+    return total;
+}
+
+/**
+ * imprimirOrdenCadena - Imprime la parentización de las matrices i..j
+ * @corte: Resultado de ordenCadena()
+ * @k: Número de matrices de la cadena
+ * @i: Primera matriz del subproducto
+ * @j: Última matriz del subproducto
+ */
+void imprimirOrdenCadena(const int *corte, int k, int i, int j) {
+    if (i == j) {
+        printf("A%d", i + 1);
+        return;
+    }
+    printf("(");
+    imprimirOrdenCadena(corte, k, i, corte[i * k + j]);
+    printf("×");
+    imprimirOrdenCadena(corte, k, corte[i * k + j] + 1, j);
+    printf(")");
+}
+
+/**
+ * picoCadena - Elementos temporales vivos al evaluar el subproducto i..j
+ * @dims: k+1 dimensiones de la cadena
+ * @corte: Resultado de ordenCadena()
+ * @k: Número de matrices de la cadena
+ * @i: Primera matriz del subproducto
+ * @j: Última matriz del subproducto
+ * @hilos: Hilos que comparten cada producto (un búfer de fila por hilo)
+ * 
+ * Sigue el orden de evalCadena(): el temporal izquierdo vive mientras se
+ * evalúa el derecho, y los temporales internos de cada lado se apilan
+ * encima del suyo. Durante el producto se suman los búferes de fila.
+ * Las matrices de entrada no ocupan arena.
+ */
+static long picoCadena(const int *dims, const int *corte, int k, int i, int j, int hilos) {
+    if (i == j) return 0;
+
+    int s = corte[i * k + j];
+    long tamIzq = (s > i) ? (long)dims[i] * dims[s + 1] : 0;
+    long tamDer = (j > s + 1) ? (long)dims[s + 1] * dims[j + 1] : 0;
+    long picoIzq = tamIzq + picoCadena(dims, corte, k, i, s, hilos);
+    long picoDer = tamIzq + tamDer + picoCadena(dims, corte, k, s + 1, j, hilos);
+    long picoProducto = tamIzq + tamDer + (long)hilos * dims[j + 1];
+    long pico = (picoIzq > picoDer) ? picoIzq : picoDer;
+    return (pico > picoProducto) ? pico : picoProducto;
+}
+
+/**
+ * memoriaCadena - Elementos de arena que necesita multiCadena()
+ * @dims: k+1 dimensiones de la cadena
+ * @corte: Resultado de ordenCadena()
+ * @k: Número de matrices de la cadena
+ */
+long memoriaCadena(const int *dims, const int *corte, int k) {
+    return picoCadena(dims, corte, k, 0, k - 1, omp_get_max_threads());
+}
+
+/**
+ * iniArena - Reserva la arena de temporales
+ * @arena: Arena a inicializar
+ * @elementos: Capacidad en doubles
+ */
+int iniArena(ArenaMatrices *arena, long elementos) {
+    arena->memoria = (double *)malloc((elementos > 0 ? elementos : 1) * sizeof(double));
+    arena->capacidad = elementos;
+    arena->usado = 0;
+    return arena->memoria != NULL;
+}
+
+/**
+ * pedirArena - Entrega elementos consecutivos de la arena
+ * @arena: Arena de temporales
+ * @elementos: Doubles solicitados
+ */
+double *pedirArena(ArenaMatrices *arena, long elementos) {
+    if (arena->usado + elementos > arena->capacidad) return NULL;
+    double *bloque = arena->memoria + arena->usado;
+    arena->usado += elementos;
+    return bloque;
+}
+
+/**
+ * liberarArena - Libera la memoria de la arena
+ * @arena: Arena de temporales
+ */
+void liberarArena(ArenaMatrices *arena) {
+    free(arena->memoria);
+    arena->memoria = NULL;
+    arena->capacidad = arena->usado = 0;
+}
+
+/**
+ * evalCadena - Evalúa el subproducto i..j en dest
+ * @mats: Matrices de la cadena
+ * @dims: k+1 dimensiones de la cadena
+ * @k: Número de matrices de la cadena
+ * @corte: Resultado de ordenCadena()
+ * @i: Primera matriz del subproducto
+ * @j: Última matriz del subproducto (j > i)
+ * @dest: Destino de dims[i] x dims[j+1]
+ * @ep: Epílogo del producto, o NULL
+ * @arena: Arena de temporales
+ * 
+ * Los lados que son una sola matriz se usan directamente, sin copia. Al
+ * terminar, la arena vuelve a su marca inicial: los temporales de este
+ * subproducto se reutilizan para el siguiente.
+ */
+static void evalCadena(double **mats, const int *dims, int k, const int *corte, int i, int j,
+                       double *dest, const Epilogo *ep, ArenaMatrices *arena) {
+    int s = corte[i * k + j];
+    long marca = arena->usado;
+    double *izq = mats[i], *der = mats[s + 1];
+
+    if (s > i) {
+        izq = pedirArena(arena, (long)dims[i] * dims[s + 1]);
+        if (!izq) {
+            fprintf(stderr, "Error: Arena de temporales insuficiente\n");
+            exit(1);
+        }
+        evalCadena(mats, dims, k, corte, i, s, izq, NULL, arena);
+    }
+    if (j > s + 1) {
+        der = pedirArena(arena, (long)dims[s + 1] * dims[j + 1]);
+        if (!der) {
+            fprintf(stderr, "Error: Arena de temporales insuficiente\n");
+            exit(1);
+        }
+        evalCadena(mats, dims, k, corte, s + 1, j, der, NULL, arena);
+    }
+
+    /* Un búfer de fila por hilo, tomado de la arena una vez por producto */
+    int hilos = omp_get_max_threads();
+    int p = dims[j + 1];
+    double *acc = pedirArena(arena, (long)hilos * p);
+    if (!acc) {
+        fprintf(stderr, "Error: Arena de temporales insuficiente\n");
+        exit(1);
+    }
+
+    /* Filas repartidas entre hilos en grupos de FILAS_CADENA; cada hilo
+     * usa su porción del búfer en multiMatrixRect() */
+    int filas = dims[i];
+    int grupos = (filas + FILAS_CADENA - 1) / FILAS_CADENA;
+    #pragma omp parallel for schedule(static) num_threads(hilos)
+    for (int g = 0; g < grupos; g++) {
+        int filaF = (g + 1) * FILAS_CADENA;
+        multiMatrixRect(izq, der, dest, filas, dims[s + 1], p, ep,
+                        g * FILAS_CADENA, (filaF < filas) ? filaF : filas,
+                        acc + (long)omp_get_thread_num() * p);
+    }
+
+    arena->usado = marca;
+}
+
+/**
+ * multiCadena - Evalúa R = epílogo(A1 × A2 × ... × Ak) en orden óptimo
+ * @mats: k matrices por filas; la matriz i es de dims[i] x dims[i+1]
+ * @dims: k+1 dimensiones de la cadena
+ * @k: Número de matrices de la cadena (al menos 2)
+ * @corte: Resultado de ordenCadena()
+ * @mR: Resultado de dims[0] x dims[k]
+ * @ep: Epílogo del producto final, o NULL
+ * @arena: Arena de temporales
+ */
+void multiCadena(double **mats, const int *dims, int k, const int *corte, double *mR,
+                 const Epilogo *ep, ArenaMatrices *arena) {
+    if (k < 2) {
+        fprintf(stderr, "Error: La cadena debe tener al menos dos matrices\n");
+        exit(1);
+    }
+    evalCadena(mats, dims, k, corte, 0, k - 1, mR, ep, arena);
+}
+
+/**
+ * escribirFila - Copia una fila calculada a su destino en C
+ * @dst: Fila destino
+ * @src: Fila calculada
+ * @D: Elementos de la fila
+ * @noTemporal: 1 para escribir sin pasar por la caché (_mm_stream_pd)
+ *
+ * Las escrituras no temporales necesitan direcciones alineadas a 16
+ * bytes: con D impar, las filas alternas empiezan con un elemento suelto.
+ * Sin SSE2 se usa siempre la copia normal.
+ */
+static void escribirFila(double *dst, const double *src, int D, int noTemporal) {
+#ifdef __SSE2__
+    if (noTemporal) {
+        int j = 0;
+        if (((uintptr_t)dst & 15) != 0) {
+            dst[0] = src[0];
+            j = 1;
+        }
+        for (; j + 1 < D; j += 2) {
+            _mm_stream_pd(dst + j, _mm_loadu_pd(src + j));
+        }
+        for (; j < D; j++) dst[j] = src[j];
+        return;
+    }
+#endif
+    memcpy(dst, src, D * sizeof(double));
+}
+
+/**
+ * multiMatrixPaneles - Multiplicación de poca memoria con paneles de B
+ * @mA: Matriz A
+ * @mB: Matriz B (no se modifica ni se transpone)
+ * @mC: Matriz resultado C (puede ser la misma que mA)
+ * @D: Dimensión de las matrices
+ * @filaI: Fila inicial del rango a procesar (inclusiva)
+ * @filaF: Fila final del rango a procesar (exclusiva)
+ * @noTemporal: 1 para escribir C con escrituras no temporales
+ *
+ * Las filas se procesan en grupos de FILAS_PANEL. Para cada grupo se
+ * recorren los paneles de P columnas de B: cada panel se copia
+ * transpuesto a un búfer de P x D (sus columnas quedan contiguas, como en
+ * B^T) y se hacen los productos punto de esas filas de A con él. El
+ * grupo terminado se escribe de una vez en C; como esas filas de A ya no
+ * se vuelven a leer, C puede sobrescribir a A.
+ */
+void multiMatrixPaneles(double *mA, double *mB, double *mC, int D, int filaI, int filaF, int noTemporal) {
+    int P = BYTES_PANEL / (int)(sizeof(double) * D) / 8 * 8;  // Múltiplo de 8
+    if (P < 8) P = 8;
+    if (P > D) P = D;
+
+    double *panel = (double *)malloc((long)P * D * sizeof(double));
+    double *filas = (double *)malloc((long)FILAS_PANEL * D * sizeof(double));
+    if (!panel || !filas) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para los paneles\n");
+        exit(1);
+    }
+
+    for (int i0 = filaI; i0 < filaF; i0 += FILAS_PANEL) {
+        int i1 = (i0 + FILAS_PANEL < filaF) ? i0 + FILAS_PANEL : filaF;
+
+        for (int j0 = 0; j0 < D; j0 += P) {
+            int ancho = (j0 + P < D) ? P : D - j0;
+
+            /* Empaquetado: columnas j0..j0+ancho de B como filas contiguas */
+            for (int k = 0; k < D; k++) {
+                const double *pB = mB + (long)k * D + j0;
+                for (int jj = 0; jj < ancho; jj++) {
+                    panel[(long)jj * D + k] = pB[jj];
+                }
+            }
+
+            /* Productos punto como en multiMatrixTrans(), contra el panel.
+             * Cuatro columnas a la vez: cuatro sumas independientes por
+             * cada lectura de A, con el mismo orden de suma por elemento */
+            for (int i = i0; i < i1; i++) {
+                const double *pA = mA + (long)i * D;
+                double *fila = filas + (long)(i - i0) * D + j0;
+                int jj = 0;
+                for (; jj + 3 < ancho; jj += 4) {
+                    const double *p0 = panel + (long)jj * D;
+                    const double *p1 = p0 + D, *p2 = p1 + D, *p3 = p2 + D;
+                    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+                    for (int k = 0; k < D; k++) {
+                        double a = pA[k];
+                        s0 += a * p0[k];
+                        s1 += a * p1[k];
+                        s2 += a * p2[k];
+                        s3 += a * p3[k];
+                    }
+                    fila[jj] = s0;
+                    fila[jj + 1] = s1;
+                    fila[jj + 2] = s2;
+                    fila[jj + 3] = s3;
+                }
+                for (; jj < ancho; jj++) {
+                    const double *pP = panel + (long)jj * D;
+                    double suma = 0.0;
+                    for (int k = 0; k < D; k++) {
+                        suma += pA[k] * pP[k];
+                    }
+                    fila[jj] = suma;
+                }
+            }
+        }
+
+        for (int i = i0; i < i1; i++) {
+            escribirFila(mC + (long)i * D, filas + (long)(i - i0) * D, D, noTemporal);
+        }
+    }
+
+#ifdef __SSE2__
+    /* Las escrituras no temporales deben ser visibles al terminar */
+    if (noTemporal) _mm_sfence();
+#endif
+
+    free(panel);
+    free(filas);
+}
@@ -33,6 +33,46 @@ void InicioMuestra();
  */
 void FinMuestra();
 
+/**
+ * tiempoActual - Devuelve el instante actual en microsegundos
+ * 
+ * Lectura independiente de InicioMuestra()/FinMuestra() que no toca las
+ * variables globales de medición. Útil cuando varias etapas o hilos
+ * necesitan medir sus propios intervalos de forma concurrente.
+ * 
+ * @return: Tiempo actual en microsegundos (gettimeofday)
+ */
+double tiempoActual();
+
+/**
+ * InicioEnergia - Registra los contadores de energía RAPL al inicio
+ *
+ * Solo actúa si la variable de entorno MM_ENERGIA vale 1. Lee los
+ * contadores de /sys/class/powercap (paquetes y DRAM). Si no existen o
+ * no se pueden leer, avisa una vez por stderr y la medición se omite.
+ */
+void InicioEnergia();
+
+/**
+ * FinEnergia - Calcula y muestra la energía consumida desde InicioEnergia
+ * @flops: Operaciones de punto flotante realizadas en el intervalo
+ *
+ * Imprime una línea "ENERGIA julios=J gflop_j=G vatios=W" después del
+ * tiempo de FinMuestra(). Corrige el desborde de los contadores con
+ * max_energy_range_uj. No imprime nada si la medición está desactivada.
+ */
+void FinEnergia(double flops);
+
+/**
+ * picoMemoriaMB - Pico de memoria residente (RSS) del proceso
+ *
+ * Lee ru_maxrss con getrusage(): incluye todas las páginas que el
+ * proceso llegó a tocar, no solo las reservadas.
+ *
+ * @return: Máximo RSS en MB desde el inicio del proceso
+ */
+double picoMemoriaMB();
+
 /**
  * iniMatrix - Inicializa dos matrices con valores aleatorios
  * @m1: Puntero a la primera matriz (valores entre 1.0 y 5.0)
@@ -86,6 +126,42 @@ int verificarMultiplicacion(double *mA, double *mB, double *mC, int D);
  */
 void multiMatrix(double *mA, double *mB, double *mC, int D, int filaI, int filaF);
 
+/**
+ * multiMatrixAcum - Multiplicación con acumulación para un rango de filas
+ * @mA: Puntero a la matriz A (multiplicando)
+ * @mB: Puntero a la matriz B (multiplicador)
+ * @mC: Puntero a la matriz C donde se acumula el producto
+ * @D: Dimensión de las matrices cuadradas (D x D)
+ * @filaI: Fila inicial del rango a procesar (inclusiva)
+ * @filaF: Fila final del rango a procesar (exclusiva)
+ * 
+ * Calcula C[i,:] += suma(A[i,k] × B[k,:]) para k=0..D-1 sin poner C a cero,
+ * de modo que sirve para sumar productos de bloques (p. ej. en SUMMA).
+ * Usa el orden i-k-j: B y C se recorren por filas (acceso secuencial).
+ */
+void multiMatrixAcum(double *mA, double *mB, double *mC, int D, int filaI, int filaF);
+
+/**
+ * multiMatrixRecursiva - Multiplicación recursiva cache-oblivious por rango de filas
+ * @mA: Puntero a la matriz A (multiplicando)
+ * @mB: Puntero a la matriz B (multiplicador)
+ * @mC: Puntero a la matriz resultado C (producto)
+ * @D: Dimensión de las matrices cuadradas (D x D)
+ * @filaI: Fila inicial del rango a procesar (inclusiva)
+ * @filaF: Fila final del rango a procesar (exclusiva)
+ * 
+ * Divide por la mitad la mayor de las dimensiones M, N o K del subproblema
+ * hasta llegar a un caso base pequeño que cabe en caché L1, resuelto con un
+ * núcleo i-k-j. No depende de un tamaño de bloque ajustado por máquina:
+ * la recursión encuentra sola el tamaño que cabe en cada nivel de caché.
+ * 
+ * Las mitades independientes (divisiones de M o N) se lanzan como tareas
+ * OpenMP; dentro de una región paralela la recursión se reparte entre
+ * hilos, y fuera de ella (Fork, Pthreads) se ejecuta en serie.
+ * Misma interfaz por rango de filas que multiMatrix().
+ */
+void multiMatrixRecursiva(double *mA, double *mB, double *mC, int D, int filaI, int filaF);
+
 /**
  * transposeMatrix - Crea la transpuesta de una matriz
  * @src: Puntero a la matriz fuente (NO se modifica)
@@ -114,4 +190,492 @@ void transposeMatrix(double *src, double *dst, int D);
  */
 void multiMatrixTrans(double *mA, double *mBT, double *mC, int D);
 
+/**
+ * multiMatrixTransFilas - Multiplicación con B^T para un rango de filas
+ * @mA: Puntero a la matriz A (multiplicando)
+ * @mBT: Puntero a la matriz B transpuesta (B^T)
+ * @mC: Puntero a la matriz resultado C (producto)
+ * @D: Dimensión de las matrices cuadradas (D x D)
+ * @filaI: Fila inicial del rango a procesar (inclusiva)
+ * @filaF: Fila final del rango a procesar (exclusiva)
+ * 
+ * Igual que multiMatrixTrans() pero solo para las filas [filaI, filaF),
+ * para repartir el producto entre procesos o hilos POSIX.
+ */
+void multiMatrixTransFilas(double *mA, double *mBT, double *mC, int D, int filaI, int filaF);
+
+/**
+ * NucleoDenso - Núcleo usado para el producto denso en Fork y Pthreads
+ * @NUCLEO_CLASICA: multiMatrix() (o el núcleo del plan de estructura)
+ * @NUCLEO_TRANS: multiMatrixTransFilas() con B^T calculada antes de medir
+ * @NUCLEO_RECURSIVA: multiMatrixRecursiva() sobre el rango de cada trabajador
+ */
+typedef enum {
+    NUCLEO_CLASICA,
+    NUCLEO_TRANS,
+    NUCLEO_RECURSIVA
+} NucleoDenso;
+
+/**
+ * parsearNucleo - Interpreta el argumento de núcleo de los programas
+ * @texto: "clasica", "trans" o "recursiva"
+ * @nucleo: Núcleo solicitado (salida)
+ * 
+ * @return: 1 si el texto es válido, 0 en caso contrario
+ */
+int parsearNucleo(const char *texto, NucleoDenso *nucleo);
+
+/**
+ * nombreNucleo - Nombre de un núcleo denso, tal como se escribe en la línea de comandos
+ * @nucleo: Núcleo
+ * 
+ * @return: Cadena constante ("clasica", "trans" o "recursiva")
+ */
+const char *nombreNucleo(NucleoDenso nucleo);
+
+/**
+ * EstructuraMatriz - Estructura detectada (o generada) de la matriz A
+ * @ESTRUCTURA_DENSA: Sin estructura aprovechable, se usa multiMatrix()
+ * @ESTRUCTURA_DISPERSA: Pocos elementos no nulos, se usa el formato CSR
+ * @ESTRUCTURA_TRI_INF: Triangular inferior (A[i,k] = 0 si k > i)
+ * @ESTRUCTURA_TRI_SUP: Triangular superior (A[i,k] = 0 si k < i)
+ * @ESTRUCTURA_BANDA: Banda de semiancho w (A[i,k] = 0 si |i-k| > w)
+ */
+typedef enum {
+    ESTRUCTURA_DENSA,
+    ESTRUCTURA_DISPERSA,
+    ESTRUCTURA_TRI_INF,
+    ESTRUCTURA_TRI_SUP,
+    ESTRUCTURA_BANDA
+} EstructuraMatriz;
+
+/**
+ * struct MatrizCSR - Matriz cuadrada en formato CSR (Compressed Sparse Row)
+ * @D: Dimensión de la matriz (D x D)
+ * @nnz: Número de elementos no nulos
+ * @filaPtr: Arreglo de D+1 posiciones; la fila i ocupa [filaPtr[i], filaPtr[i+1])
+ * @colIdx: Columna de cada elemento no nulo
+ * @valores: Valor de cada elemento no nulo
+ */
+typedef struct {
+    int D;
+    int nnz;
+    int *filaPtr;
+    int *colIdx;
+    double *valores;
+} MatrizCSR;
+
+/**
+ * struct PlanEstructura - Núcleo elegido para multiplicar A según su estructura
+ * @tipo: Estructura detectada por prepararPlan()
+ * @densidad: Fracción de elementos no nulos de A medida (0.0 a 1.0)
+ * @ancho: Semiancho de banda medido (máx |i-k| con A[i,k] != 0)
+ * @csr: Representación CSR de A (solo si tipo == ESTRUCTURA_DISPERSA)
+ */
+typedef struct {
+    EstructuraMatriz tipo;
+    double densidad;
+    int ancho;
+    MatrizCSR csr;
+} PlanEstructura;
+
+/**
+ * parsearEstructura - Interpreta el argumento de estructura de los programas
+ * @texto: "densa", "tri", "trisup", "banda:W" o una densidad (p. ej. "0.05")
+ * @tipo: Estructura solicitada (salida)
+ * @parametro: Densidad para ESTRUCTURA_DISPERSA o semiancho W para banda (salida)
+ * 
+ * W debe ser un entero no negativo y la densidad un número entre 0 y 1;
+ * "banda:", "banda:2.5" o "nan" no son válidos.
+ * 
+ * @return: 1 si el texto es válido, 0 en caso contrario
+ */
+int parsearEstructura(const char *texto, EstructuraMatriz *tipo, double *parametro);
+
+/**
+ * iniMatrixEstructurada - Inicializa A con la estructura pedida y B densa
+ * @m1: Matriz A (valores entre 1.0 y 5.0 donde no es cero)
+ * @m2: Matriz B densa (valores entre 5.0 y 9.0)
+ * @D: Dimensión de las matrices cuadradas (D x D)
+ * @tipo: Estructura de A
+ * @parametro: Densidad (dispersa) o semiancho de banda (banda)
+ * 
+ * Llama a iniMatrix() y luego anula los elementos de A que quedan fuera
+ * de la estructura. Con ESTRUCTURA_DENSA equivale a iniMatrix().
+ */
+void iniMatrixEstructurada(double *m1, double *m2, int D, EstructuraMatriz tipo, double parametro);
+
+/**
+ * prepararPlan - Mide la estructura de A y elige el núcleo de multiplicación
+ * @mA: Matriz A en formato denso por filas
+ * @D: Dimensión de la matriz cuadrada (D x D)
+ * @plan: Plan resultante (debe liberarse con liberarPlan)
+ * 
+ * Recorre A una vez para medir densidad, semiancho de banda y si es
+ * triangular. Elige, en este orden: banda angosta, triangular, CSR si la
+ * densidad es baja y, en cualquier otro caso, el camino denso habitual.
+ * 
+ * @return: 1 si éxito, 0 si no se pudo reservar memoria para el CSR
+ */
+int prepararPlan(double *mA, int D, PlanEstructura *plan);
+
+/**
+ * liberarPlan - Libera la memoria asociada a un plan
+ * @plan: Plan creado con prepararPlan()
+ */
+void liberarPlan(PlanEstructura *plan);
+
+/**
+ * nombreEstructura - Nombre legible de una estructura
+ * @tipo: Estructura
+ * 
+ * @return: Cadena constante ("densa", "dispersa (CSR)", ...)
+ */
+const char *nombreEstructura(EstructuraMatriz tipo);
+
+/**
+ * multiMatrixCSR - Multiplicación CSR × densa para un rango de filas
+ * @A: Matriz A en formato CSR
+ * @mB: Matriz B densa
+ * @mC: Matriz resultado C densa
+ * @D: Dimensión de las matrices cuadradas (D x D)
+ * @filaI: Fila inicial del rango a procesar (inclusiva)
+ * @filaF: Fila final del rango a procesar (exclusiva)
+ * 
+ * Para cada elemento no nulo A[i,k] acumula A[i,k] × B[k,:] en C[i,:].
+ * Solo recorre los no nulos y accede a B y C por filas (acceso secuencial).
+ */
+void multiMatrixCSR(const MatrizCSR *A, double *mB, double *mC, int D, int filaI, int filaF);
+
+/**
+ * multiMatrixTriangular - Multiplicación con A triangular para un rango de filas
+ * @mA: Matriz A triangular (inferior o superior) en formato denso
+ * @mB: Matriz B densa
+ * @mC: Matriz resultado C
+ * @D: Dimensión de las matrices cuadradas (D x D)
+ * @inferior: 1 si A es triangular inferior, 0 si es superior
+ * @filaI: Fila inicial del rango a procesar (inclusiva)
+ * @filaF: Fila final del rango a procesar (exclusiva)
+ * 
+ * Omite la mitad de ceros de A: en la fila i solo recorre k <= i
+ * (inferior) o k >= i (superior).
+ */
+void multiMatrixTriangular(double *mA, double *mB, double *mC, int D, int inferior,
+                           int filaI, int filaF);
+
+/**
+ * multiMatrixBanda - Multiplicación con A de banda para un rango de filas
+ * @mA: Matriz A de banda en formato denso
+ * @mB: Matriz B densa
+ * @mC: Matriz resultado C
+ * @D: Dimensión de las matrices cuadradas (D x D)
+ * @ancho: Semiancho de banda w de A
+ * @filaI: Fila inicial del rango a procesar (inclusiva)
+ * @filaF: Fila final del rango a procesar (exclusiva)
+ * 
+ * En la fila i solo recorre k en [i-w, i+w], con costo O(D × (2w+1))
+ * por fila en lugar de O(D²).
+ */
+void multiMatrixBanda(double *mA, double *mB, double *mC, int D, int ancho,
+                      int filaI, int filaF);
+
+/**
+ * multiMatrixPlan - Multiplica un rango de filas con el núcleo del plan
+ * @plan: Plan creado con prepararPlan()
+ * @mA: Matriz A densa (usada por los caminos denso, triangular y banda)
+ * @mB: Matriz B densa
+ * @mC: Matriz resultado C
+ * @D: Dimensión de las matrices cuadradas (D x D)
+ * @filaI: Fila inicial del rango a procesar (inclusiva)
+ * @filaF: Fila final del rango a procesar (exclusiva)
+ * 
+ * Misma interfaz por rango de filas que multiMatrix(), por lo que los
+ * programas Fork, Pthreads y OpenMP pueden usarla sin cambiar su reparto.
+ * Con ESTRUCTURA_DENSA delega directamente en multiMatrix().
+ */
+void multiMatrixPlan(const PlanEstructura *plan, double *mA, double *mB, double *mC, int D,
+                     int filaI, int filaF);
+
+/**
+ * flopsPlan - Operaciones de punto flotante del producto con el núcleo del plan
+ * @plan: Plan creado con prepararPlan()
+ * @D: Dimensión de las matrices cuadradas (D x D)
+ * 
+ * Cuenta los productos y sumas que hace realmente cada núcleo: 2·nnz·D
+ * con CSR, D²·(D+1) con triangular, 2·D·(elementos de la banda) con banda
+ * y 2·D³ con el camino denso. Es la cantidad que debe pasarse a FinEnergia()
+ * para que GFLOP/J no cuente trabajo que el núcleo se salta.
+ * 
+ * @return: Número de operaciones (double para no desbordar con D grande)
+ */
+double flopsPlan(const PlanEstructura *plan, int D);
+
+/**
+ * tamanoFijoSoportado - Indica si existe un núcleo especializado para D
+ * @D: Dimensión de las matrices cuadradas (D x D)
+ * 
+ * Los núcleos especializados se generan en tiempo de compilación con la
+ * macro DEFINIR_MULTI_FIJA de mmCommon.c para D = 4, 8, 16 y 32.
+ * 
+ * @return: 1 si D tiene núcleo especializado, 0 si se usa el genérico
+ */
+int tamanoFijoSoportado(int D);
+
+/**
+ * multiMatrixLote - Multiplica un rango de un lote de matrices pequeñas
+ * @mA: Lote de matrices A contiguas (la matriz b empieza en mA + b*D*D)
+ * @mB: Lote de matrices B contiguas, con la misma disposición
+ * @mC: Lote de matrices resultado C contiguas, con la misma disposición
+ * @D: Dimensión de cada matriz cuadrada (D x D)
+ * @loteI: Primera matriz del rango a procesar (inclusiva)
+ * @loteF: Última matriz del rango a procesar (exclusiva)
+ * 
+ * Calcula C[b] = A[b] × B[b] para b en [loteI, loteF). Pensada para miles
+ * de productos diminutos (4x4 a 32x32): la paralelización se hace entre
+ * matrices del lote, no dentro de cada producto, igual que multiMatrix()
+ * reparte filas. Usa el núcleo especializado si tamanoFijoSoportado(D).
+ */
+void multiMatrixLote(double *mA, double *mB, double *mC, int D, int loteI, int loteF);
+
+/**
+ * LayoutMatriz - Disposición en memoria de una matriz cuadrada D x D
+ * @LAYOUT_FILAS: Por filas, elemento (i,j) en i*D + j (la usada por el resto)
+ * @LAYOUT_COLUMNAS: Por columnas, elemento (i,j) en j*D + i
+ * @LAYOUT_BLOQUES: Bloques tb x tb contiguos, bloques ordenados por filas
+ * @LAYOUT_MORTON: Bloques tb x tb contiguos, bloques en orden Z (Morton)
+ * 
+ * En los layouts por bloques cada bloque se guarda por filas y la matriz
+ * se rellena con ceros hasta un múltiplo de tb (y, en Morton, hasta una
+ * malla de bloques de lado potencia de 2). Ver tamanoLayout().
+ */
+typedef enum {
+    LAYOUT_FILAS,
+    LAYOUT_COLUMNAS,
+    LAYOUT_BLOQUES,
+    LAYOUT_MORTON
+} LayoutMatriz;
+
+/**
+ * tamanoLayout - Número de elementos que ocupa una matriz en un layout
+ * @layout: Disposición en memoria
+ * @D: Dimensión de la matriz cuadrada (D x D)
+ * @tb: Lado de bloque (solo layouts por bloques)
+ * 
+ * @return: Elementos a reservar, incluido el relleno de los bloques
+ */
+long tamanoLayout(LayoutMatriz layout, int D, int tb);
+
+/**
+ * indiceLayout - Posición del elemento (i,j) dentro de un layout
+ * @layout: Disposición en memoria
+ * @i: Fila del elemento
+ * @j: Columna del elemento
+ * @D: Dimensión de la matriz cuadrada (D x D)
+ * @tb: Lado de bloque (solo layouts por bloques)
+ * 
+ * @return: Desplazamiento del elemento desde el inicio del arreglo
+ */
+long indiceLayout(LayoutMatriz layout, int i, int j, int D, int tb);
+
+/**
+ * convertirLayout - Copia una matriz de un layout a otro
+ * @src: Matriz fuente (NO se modifica)
+ * @lsrc: Layout de la fuente
+ * @dst: Matriz destino con tamanoLayout(ldst, D, tb) elementos
+ * @ldst: Layout del destino
+ * @D: Dimensión de la matriz cuadrada (D x D)
+ * @tb: Lado de bloque (solo layouts por bloques)
+ * 
+ * Recorre el destino en su orden de almacenamiento para que las
+ * escrituras sean secuenciales, y reparte ese recorrido entre hilos
+ * OpenMP cuando se llama desde fuera de una región paralela. El relleno
+ * de los layouts por bloques queda en cero.
+ */
+void convertirLayout(double *src, LayoutMatriz lsrc, double *dst, LayoutMatriz ldst, int D, int tb);
+
+/**
+ * multiMatrixBloques - Multiplicación nativa en layout por bloques
+ * @mA: Matriz A en LAYOUT_BLOQUES o LAYOUT_MORTON
+ * @mB: Matriz B en el mismo layout que A
+ * @mC: Matriz resultado C en el mismo layout que A
+ * @layout: LAYOUT_BLOQUES o LAYOUT_MORTON
+ * @D: Dimensión de las matrices cuadradas (D x D)
+ * @tb: Lado de bloque
+ * @bloqueI: Fila de bloques inicial del rango a procesar (inclusiva)
+ * @bloqueF: Fila de bloques final del rango a procesar (exclusiva)
+ * 
+ * Equivalente por bloques de multiMatrix(): el rango se expresa en filas
+ * de bloques, de 0 a ceil(D/tb). Cada producto de bloques opera sobre
+ * tres bloques contiguos con multiMatrixAcum(), sin transponer B ni
+ * recorrer columnas, por lo que los operandos pueden reutilizarse en
+ * este layout durante muchas multiplicaciones seguidas.
+ */
+void multiMatrixBloques(double *mA, double *mB, double *mC, LayoutMatriz layout, int D, int tb,
+                        int bloqueI, int bloqueF);
+
+/**
+ * OperacionElemento - Operación elemento a elemento del epílogo
+ * @OPERACION_NINGUNA: Identidad
+ * @OPERACION_RELU: max(x, 0)
+ * @OPERACION_TANH: Tangente hiperbólica
+ */
+typedef enum {
+    OPERACION_NINGUNA,
+    OPERACION_RELU,
+    OPERACION_TANH
+} OperacionElemento;
+
+/**
+ * struct Epilogo - Operaciones fusionadas en la escritura de C
+ * @alfa: Escala del producto A×B
+ * @beta: Escala del contenido previo de C (0.0 lo ignora sin leerlo)
+ * @sesgo: Vector de p elementos sumado a cada fila de C, o NULL
+ * @op: Operación aplicada a cada elemento al final
+ * 
+ * Con el epílogo, C[i,j] = op(alfa·(A×B)[i,j] + beta·C[i,j] + sesgo[j]),
+ * en una sola escritura de cada elemento de C.
+ */
+typedef struct {
+    double alfa;
+    double beta;
+    const double *sesgo;
+    OperacionElemento op;
+} Epilogo;
+
+/**
+ * struct ArenaMatrices - Memoria reservada una vez para los temporales
+ * @memoria: Bloque de doubles
+ * @capacidad: Elementos del bloque
+ * @usado: Elementos entregados; se libera en orden de pila restaurándolo
+ */
+typedef struct {
+    double *memoria;
+    long capacidad;
+    long usado;
+} ArenaMatrices;
+
+/**
+ * multiMatrixRect - Multiplicación rectangular con epílogo fusionado
+ * @mA: Matriz A de m x n
+ * @mB: Matriz B de n x p
+ * @mC: Matriz resultado C de m x p (leída solo si beta != 0)
+ * @m: Filas de A y de C
+ * @n: Columnas de A / filas de B
+ * @p: Columnas de B y de C
+ * @ep: Epílogo a aplicar, o NULL para C = A×B
+ * @filaI: Fila inicial del rango a procesar (inclusiva)
+ * @filaF: Fila final del rango a procesar (exclusiva)
+ * @acc: Búfer de p elementos del hilo que llama (no se reserva memoria aquí)
+ * 
+ * Acumula cada fila de A×B en el búfer @acc (orden i-k-j) y la escribe
+ * en C aplicando el epílogo, sin pasadas adicionales sobre C.
+ */
+void multiMatrixRect(const double *mA, const double *mB, double *mC, int m, int n, int p,
+                     const Epilogo *ep, int filaI, int filaF, double *acc);
+
+/**
+ * ordenCadena - Parentización óptima de un producto de k matrices
+ * @dims: k+1 dimensiones; la matriz i es de dims[i] x dims[i+1]
+ * @k: Número de matrices de la cadena
+ * @corte: Matriz k x k de salida; corte[i*k+j] es el índice s en que se
+ *         divide el subproducto i..j como (i..s)(s+1..j)
+ * 
+ * Programación dinámica clásica en O(k³).
+ * 
+ * @return: Multiplicaciones escalares del orden óptimo
+ */
+double ordenCadena(const int *dims, int k, int *corte);
+
+/**
+ * costoIzquierdaDerecha - Multiplicaciones escalares de ((A1 A2) A3)...
+ * @dims: k+1 dimensiones de la cadena
+ * @k: Número de matrices de la cadena
+ * 
+ * @return: Costo del orden ingenuo, para comparar con ordenCadena()
+ */
+double costoIzquierdaDerecha(const int *dims, int k);
+
+/**
+ * imprimirOrdenCadena - Imprime la parentización de las matrices i..j
+ * @corte: Resultado de ordenCadena()
+ * @k: Número de matrices de la cadena
+ * @i: Primera matriz del subproducto
+ * @j: Última matriz del subproducto
+ */
+void imprimirOrdenCadena(const int *corte, int k, int i, int j);
+
+/**
+ * memoriaCadena - Elementos de arena que necesita multiCadena()
+ * @dims: k+1 dimensiones de la cadena
+ * @corte: Resultado de ordenCadena()
+ * @k: Número de matrices de la cadena
+ * 
+ * Incluye un búfer de fila por hilo para cada producto, según
+ * omp_get_max_threads(): fije el número de hilos antes de llamarla.
+ * 
+ * @return: Máximo de elementos temporales vivos a la vez
+ */
+long memoriaCadena(const int *dims, const int *corte, int k);
+
+/**
+ * iniArena - Reserva la arena de temporales
+ * @arena: Arena a inicializar
+ * @elementos: Capacidad en doubles (p. ej. memoriaCadena())
+ * 
+ * @return: 1 si éxito, 0 si no hay memoria
+ */
+int iniArena(ArenaMatrices *arena, long elementos);
+
+/**
+ * pedirArena - Entrega elementos consecutivos de la arena
+ * @arena: Arena de temporales
+ * @elementos: Doubles solicitados
+ * 
+ * @return: Puntero al inicio del bloque, o NULL si no hay capacidad
+ */
+double *pedirArena(ArenaMatrices *arena, long elementos);
+
+/**
+ * liberarArena - Libera la memoria de la arena
+ * @arena: Arena de temporales
+ */
+void liberarArena(ArenaMatrices *arena);
+
+/**
+ * multiCadena - Evalúa R = epílogo(A1 × A2 × ... × Ak) en orden óptimo
+ * @mats: k matrices por filas; la matriz i es de dims[i] x dims[i+1]
+ * @dims: k+1 dimensiones de la cadena
+ * @k: Número de matrices de la cadena
+ * @corte: Resultado de ordenCadena()
+ * @mR: Resultado de dims[0] x dims[k] (con beta != 0, contiene C)
+ * @ep: Epílogo del producto final, o NULL
+ * @arena: Arena con al menos memoriaCadena() elementos libres
+ * 
+ * Los productos intermedios se escriben en la arena, que se libera en
+ * orden de pila en cuanto se consumen, y solo el último producto aplica
+ * el epílogo. Cada producto reparte sus filas entre hilos OpenMP.
+ */
+void multiCadena(double **mats, const int *dims, int k, const int *corte, double *mR,
+                 const Epilogo *ep, ArenaMatrices *arena);
+
+/**
+ * multiMatrixPaneles - Multiplicación de poca memoria con paneles de B
+ * @mA: Puntero a la matriz A (multiplicando)
+ * @mB: Puntero a la matriz B (multiplicador, no se modifica)
+ * @mC: Puntero a la matriz resultado C; puede ser igual a mA, y entonces
+ *      el resultado sobrescribe a A
+ * @D: Dimensión de las matrices cuadradas (D x D)
+ * @filaI: Fila inicial del rango a procesar (inclusiva)
+ * @filaF: Fila final del rango a procesar (exclusiva)
+ * @noTemporal: 1 para escribir C con escrituras no temporales (SSE2)
+ * 
+ * Alternativa a transposeMatrix() + multiMatrixTrans() que no necesita
+ * la matriz B^T completa: solo empaqueta transpuesto el panel de
+ * columnas de B en uso, en búferes propios de la llamada (P x D y
+ * FILAS_PANEL x D doubles). Con mC == mA el producto usa dos matrices
+ * N x N en lugar de cuatro. Las escrituras no temporales evitan que C
+ * desplace de la caché a A y al panel.
+ */
+void multiMatrixPaneles(double *mA, double *mB, double *mC, int D, int filaI, int filaF, int noTemporal);
+
 #endif /* MM_COMMON_H */
@@ -11,15 +11,22 @@
 #*              Crea B^T (transpuesta de B) y multiplica A × B^T, lo que permite
 #*              acceso secuencial a memoria en lugar de saltos, reduciendo fallos
 #*              de caché. Paraleliza con OpenMP. Usa biblioteca mmCommon.
+#*              En modo de poca memoria ("bajo"/"bajoNT") no crea B^T ni C:
+#*              empaqueta solo el panel de B en uso por hilo y escribe C sobre
+#*              A, con escrituras no temporales opcionales; en ese modo reporta el pico RSS.
 #* Versión: Paralelismo con OpenMP - Algoritmo Transpuesta Optimizado
 ######################################################################################*/
 
 #include "mmCommon.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <omp.h>
 
+/* Dimensión máxima verificada en modo bajo (cubre varios paneles de B) */
+#define N_MAX_VERIFICACION_BAJO 320
+
 /**
  * impMatrixCustom - Imprime una matriz con opciones de formato personalizadas
  * @matrix: Puntero a la matriz a imprimir
@@ -97,10 +104,32 @@ void multiMatrixTransOpenMP(double *mA, double *mBT, double *mC, int D) {
     }
 }
 
+/**
+ * multiMatrixPanelesOpenMP - Multiplicación de poca memoria con OpenMP
+ * @mA: Puntero a la matriz A (se sobrescribe si mC == mA)
+ * @mB: Puntero a la matriz B
+ * @mC: Puntero a la matriz resultado C
+ * @D: Dimensión de las matrices cuadradas (D x D)
+ * @noTemporal: 1 para escribir C con escrituras no temporales
+ *
+ * Cada hilo procesa un rango contiguo de filas con sus propios paneles;
+ * como solo lee y escribe sus filas de A y C, C puede ser A.
+ */
+void multiMatrixPanelesOpenMP(double *mA, double *mB, double *mC, int D, int noTemporal) {
+    #pragma omp parallel
+    {
+        int idH = omp_get_thread_num();
+        int nH = omp_get_num_threads();
+        int filaI = (long)D * idH / nH;
+        int filaF = (long)D * (idH + 1) / nH;
+        multiMatrixPaneles(mA, mB, mC, D, filaI, filaF, noTemporal);
+    }
+}
+
 /**
  * main - Programa principal para multiplicación con transpuesta y OpenMP
  * @argc: Cantidad de argumentos de línea de comandos
- * @argv: Vector de argumentos [programa, tamaño_matriz, num_hilos]
+ * @argv: Vector de argumentos [programa, tamaño_matriz, num_hilos, modo]
  * 
  * Algoritmo:
  * 1. Valida argumentos de entrada
@@ -112,28 +141,43 @@ void multiMatrixTransOpenMP(double *mA, double *mBT, double *mC, int D) {
  * 7. Mide tiempo de ejecución y verifica correctitud usando B ORIGINAL
  * 8. Libera todas las matrices
  * 
+ * En modo "bajo" se omiten B^T y C (pasos 3 y 5): el resultado queda en
+ * la memoria de A y solo se guarda una copia de A para verificar.
+ * 
  * @return: 0 si éxito, 1 si error
  */
 int main(int argc, char *argv[]) {
     /* Validación de argumentos */
     if (argc < 3) {
-        printf("\n \t\tUse: $./mmFilasOpenMP SIZE Hilos\n");
+        printf("\n \t\tUse: $./mmFilasOpenMP SIZE Hilos [Modo]\n");
         printf("\t\tSIZE: Dimensión de la matriz cuadrada (NxN)\n");
-        printf("\t\tHilos: Número de hilos OpenMP paralelos\n\n");
+        printf("\t\tHilos: Número de hilos OpenMP paralelos\n");
+        printf("\t\tModo: normal (defecto), bajo (poca memoria) o bajoNT\n");
+        printf("\t\t      (poca memoria con escrituras no temporales de C)\n\n");
         exit(0);
     }
 
     int N = atoi(argv[1]);     // Dimensión de la matriz
     int TH = atoi(argv[2]);    // Número de hilos OpenMP
+    const char *modo = (argc > 3) ? argv[3] : "normal";
+    int bajo = (strcmp(modo, "bajo") == 0 || strcmp(modo, "bajoNT") == 0);
+    int noTemporal = (strcmp(modo, "bajoNT") == 0);
+
+    if (!bajo && strcmp(modo, "normal") != 0) {
+        fprintf(stderr, "Error: Modo no reconocido: %s\n", modo);
+        exit(1);
+    }
 
     /* Asignación de memoria para matrices (inicializada a cero)
-     * Nota: matrixB_T es matriz adicional para almacenar la transpuesta */
-    double *matrixA = (double *)calloc(N * N, sizeof(double));
-    double *matrixB = (double *)calloc(N * N, sizeof(double));
-    double *matrixB_T = (double *)calloc(N * N, sizeof(double));
-    double *matrixC = (double *)calloc(N * N, sizeof(double));
+     * Nota: matrixB_T es matriz adicional para almacenar la transpuesta;
+     * en modo bajo no existe y C comparte la memoria de A */
+    long elementos = (long)N * N;
+    double *matrixA = (double *)calloc(elementos, sizeof(double));
+    double *matrixB = (double *)calloc(elementos, sizeof(double));
+    double *matrixB_T = bajo ? NULL : (double *)calloc(elementos, sizeof(double));
+    double *matrixC = bajo ? matrixA : (double *)calloc(elementos, sizeof(double));
 
-    if (!matrixA || !matrixB || !matrixB_T || !matrixC) {
+    if (!matrixA || !matrixB || (!bajo && (!matrixB_T || !matrixC))) {
         fprintf(stderr, "Error: No se pudo asignar memoria para matrices\n");
         exit(1);
     }
@@ -147,28 +191,56 @@ int main(int argc, char *argv[]) {
     impMatrixCustom(matrixA, N, 0);
     impMatrixCustom(matrixB, N, 0);
 
+    /* En modo bajo A se sobrescribe: copia para verificar. El límite cubre
+     * varios paneles y grupos de filas por hilo, donde C pisa a A */
+    double *copiaA = NULL;
+    int verificar = bajo ? (N <= N_MAX_VERIFICACION_BAJO) : (N < 6);
+    if (bajo && verificar) {
+        copiaA = (double *)malloc(elementos * sizeof(double));
+        if (!copiaA) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para matrices\n");
+            exit(1);
+        }
+        memcpy(copiaA, matrixA, elementos * sizeof(double));
+    }
+
     /* Crear transpuesta de B sin modificar B original
      * Esta es la clave de la optimización: B^T permite acceso secuencial */
-    transposeMatrix(matrixB, matrixB_T, N);
+    if (!bajo) {
+        transposeMatrix(matrixB, matrixB_T, N);
 
-    /* Impresión de B^T para verificación visual (solo matrices pequeñas) */
-    if (N < 6) {
-        printf("\nMatriz B Transpuesta (B^T):\n");
-        impMatrixCustom(matrixB_T, N, 0);
+        /* Impresión de B^T para verificación visual (solo matrices pequeñas) */
+        if (N < 6) {
+            printf("\nMatriz B Transpuesta (B^T):\n");
+            impMatrixCustom(matrixB_T, N, 0);
+        }
     }
 
     /* Medición de tiempo de ejecución de la multiplicación optimizada */
+    InicioEnergia();
     InicioMuestra();
-    multiMatrixTransOpenMP(matrixA, matrixB_T, matrixC, N);
+    if (bajo) {
+        multiMatrixPanelesOpenMP(matrixA, matrixB, matrixC, N, noTemporal);
+    } else {
+        multiMatrixTransOpenMP(matrixA, matrixB_T, matrixC, N);
+    }
     FinMuestra();
+    FinEnergia(2.0 * N * N * N);
+
+    /* Solo en modo bajo: en modo normal la salida sigue siendo solo el tiempo */
+    if (bajo) {
+        printf("Memoria: modo %s, 2 matrices de %.1f MB, pico RSS %.1f MB\n", modo,
+               elementos * sizeof(double) / (1024.0 * 1024.0), picoMemoriaMB());
+    }
 
     /* Impresión del resultado */
     impMatrixCustom(matrixC, N, 0);
 
-    /* Verificación de correctitud para matrices pequeñas
+    /* Verificación de correctitud (matrices pequeñas; en modo bajo, hasta
+     * N_MAX_VERIFICACION_BAJO aunque no se impriman)
      * IMPORTANTE: Verifica usando B ORIGINAL, no B^T */
-    if (N < 6) {
-        if (verificarMultiplicacion(matrixA, matrixB, matrixC, N)) {
+    if (verificar) {
+        if (verificarMultiplicacion(bajo ? copiaA : matrixA, matrixB, matrixC, N)) {
             printf("\n[OK] Verificación: Multiplicación correcta\n");
         } else {
             printf("\n[ERROR] Verificación: Multiplicación incorrecta\n");
@@ -178,8 +250,11 @@ int main(int argc, char *argv[]) {
     /* Liberación de memoria (incluye B^T adicional) */
     free(matrixA);
     free(matrixB);
-    free(matrixB_T);
-    free(matrixC);
+    if (!bajo) {
+        free(matrixB_T);
+        free(matrixC);
+    }
+    free(copiaA);
 
     return 0;
 }
@@ -0,0 +1,144 @@
+/*#######################################################################################
+#* Pontificia Universidad Javeriana
+#* Fecha: Noviembre 2025
+#* Autores: Juan David Garzon Ballen
+#*          Juan Pablo Sanchez
+#* Materia: Sistemas Operativos
+#* Tema: Taller de Evaluación de Rendimiento
+#* Programa: Multiplicación de Matrices - Lotes de matrices pequeñas con OpenMP
+#* Descripción: Programa principal que multiplica miles de pares de matrices
+#*              pequeñas (4x4 a 32x32) almacenadas de forma contigua. En lugar
+#*              de paralelizar dentro de cada producto, reparte las matrices
+#*              del lote entre los hilos OpenMP. Para 4, 8, 16 y 32 cada
+#*              producto usa el núcleo especializado de mmCommon generado
+#*              para su tamaño fijo; los demás tamaños, el genérico.
+#* Versión: Paralelismo con OpenMP - Lotes de Matrices Pequeñas
+######################################################################################*/
+
+#include "mmCommon.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <omp.h>
+
+/* Tamaño máximo verificado: cubre todos los núcleos especializados (4 a 32)
+ * y el genérico para los tamaños intermedios */
+#define N_MAX_VERIFICACION 32
+
+/**
+ * multiMatrixLoteOpenMP - Multiplica todo el lote repartiéndolo entre hilos
+ * @mA: Lote de matrices A contiguas
+ * @mB: Lote de matrices B contiguas
+ * @mC: Lote de matrices resultado C contiguas
+ * @D: Dimensión de cada matriz cuadrada (D x D)
+ * @lote: Número de matrices del lote
+ *
+ * Cada hilo recibe un bloque contiguo de matrices (el último toma el
+ * residuo, como en mmClasicaFork) y lo procesa con multiMatrixLote().
+ */
+void multiMatrixLoteOpenMP(double *mA, double *mB, double *mC, int D, int lote) {
+    #pragma omp parallel
+    {
+        int nH = omp_get_num_threads();
+        int idH = omp_get_thread_num();
+        int porHilo = lote / nH;
+        int loteI = idH * porHilo;
+        int loteF = (idH == nH - 1) ? lote : loteI + porHilo;
+
+        multiMatrixLote(mA, mB, mC, D, loteI, loteF);
+    }
+}
+
+/**
+ * main - Programa principal para multiplicación de lotes con OpenMP
+ * @argc: Cantidad de argumentos de línea de comandos
+ * @argv: Vector de argumentos [programa, tamaño_matriz, num_hilos, num_matrices]
+ *
+ * Algoritmo:
+ * 1. Valida argumentos de entrada
+ * 2. Asigna memoria contigua para los lotes A, B y C
+ * 3. Inicializa cada par de matrices con valores aleatorios
+ * 4. Multiplica el lote completo repartiendo matrices entre hilos
+ * 5. Mide tiempo de ejecución y verifica todo el lote (N <= 32)
+ * 6. Libera memoria
+ *
+ * @return: 0 si éxito, 1 si error
+ */
+int main(int argc, char *argv[]) {
+    /* Validación de argumentos */
+    if (argc < 3) {
+        printf("\n \t\tUse: $./mmLoteOpenMP SIZE Hilos [Matrices]\n");
+        printf("\t\tSIZE: Dimensión de cada matriz cuadrada (NxN)\n");
+        printf("\t\tHilos: Número de hilos OpenMP paralelos\n");
+        printf("\t\tMatrices: Número de productos del lote (por defecto 10000)\n\n");
+        exit(0);
+    }
+
+    int N = atoi(argv[1]);                           // Dimensión de cada matriz
+    int TH = atoi(argv[2]);                          // Número de hilos OpenMP
+    int lote = (argc > 3) ? atoi(argv[3]) : 10000;   // Número de matrices
+
+    if (N <= 0 || TH <= 0 || lote <= 0) {
+        fprintf(stderr, "Error: Todos los argumentos deben ser positivos\n");
+        exit(1);
+    }
+
+    /* Asignación de memoria contigua para los lotes */
+    long tam = (long)N * N;
+    double *lotA = (double *)calloc(tam * lote, sizeof(double));
+    double *lotB = (double *)calloc(tam * lote, sizeof(double));
+    double *lotC = (double *)calloc(tam * lote, sizeof(double));
+
+    if (!lotA || !lotB || !lotC) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para matrices\n");
+        exit(1);
+    }
+
+    /* Configuración de OpenMP */
+    srand(time(NULL));
+    omp_set_num_threads(TH);
+
+    /* Inicialización de cada par de matrices del lote */
+    for (int b = 0; b < lote; b++) {
+        iniMatrix(lotA + b * tam, lotB + b * tam, N);
+    }
+    impMatrix(lotA, N);
+    impMatrix(lotB, N);
+
+    /* Medición de tiempo de ejecución del lote completo */
+    InicioEnergia();
+    InicioMuestra();
+    double inicio = tiempoActual();
+    multiMatrixLoteOpenMP(lotA, lotB, lotC, N, lote);
+    double total = tiempoActual() - inicio;
+    FinMuestra();
+    FinEnergia(2.0 * N * N * N * lote);
+
+    /* Resumen del lote: núcleo usado y rendimiento */
+    printf("Lote: %d matrices %dx%d, núcleo %s, %.2f GFLOP/s\n", lote, N, N,
+           tamanoFijoSoportado(N) ? "especializado" : "genérico",
+           total > 0 ? 2.0 * tam * N * lote / (total * 1e3) : 0.0);
+
+    /* Impresión del primer resultado (solo matrices pequeñas) */
+    impMatrix(lotC, N);
+
+    /* Verificación de correctitud de todo el lote (tamaños de este programa) */
+    if (N <= N_MAX_VERIFICACION) {
+        int correctas = 1;
+        for (int b = 0; b < lote && correctas; b++) {
+            correctas = verificarMultiplicacion(lotA + b * tam, lotB + b * tam, lotC + b * tam, N);
+        }
+        if (correctas) {
+            printf("\n[OK] Verificación: Multiplicación correcta\n");
+        } else {
+            printf("\n[ERROR] Verificación: Multiplicación incorrecta\n");
+        }
+    }
+
+    /* Liberación de memoria */
+    free(lotA);
+    free(lotB);
+    free(lotC);
+
+    return 0;
+}
@@ -0,0 +1,422 @@
+/*#######################################################################################
+#* Pontificia Universidad Javeriana
+#* Fecha: Noviembre 2025
+#* Autores: Juan David Garzon Ballen
+#*          Juan Pablo Sanchez
+#* Materia: Sistemas Operativos
+#* Tema: Taller de Evaluación de Rendimiento
+#* Programa: Multiplicación de Matrices - Flujo de trabajos en tubería (pipeline)
+#* Descripción: Programa principal que procesa una secuencia de multiplicaciones
+#*              independientes mediante tres etapas concurrentes conectadas por
+#*              colas acotadas: (1) generación de A y B, (2) multiplicación con
+#*              multiMatrix repartida entre hilos POSIX, (3) verificación y
+#*              almacenamiento del resultado. Mientras una matriz se multiplica,
+#*              la siguiente se está generando y la anterior se está verificando,
+#*              de modo que los núcleos no quedan ociosos entre productos.
+#*              Al final reporta el rendimiento y la ocupación de cada etapa.
+#* Versión: Paralelismo con Hilos Pthreads "POSIX" en tubería
+######################################################################################*/
+
+#include "mmCommon.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+/**
+ * struct trabajo - Una multiplicación independiente que recorre la tubería
+ * @id: Número de secuencia del trabajo (0 a numTrabajos-1)
+ * @mA: Matriz A (multiplicando)
+ * @mB: Matriz B (multiplicador)
+ * @mC: Matriz resultado C (producto)
+ */
+struct trabajo {
+    int id;
+    double *mA, *mB, *mC;
+};
+
+/**
+ * struct cola - Cola circular acotada entre dos etapas de la tubería
+ * @datos: Arreglo circular de punteros a trabajos
+ * @capacidad: Número máximo de trabajos en espera (buffer acotado)
+ * @cabeza: Posición del próximo trabajo a extraer
+ * @cuenta: Número de trabajos actualmente en la cola
+ * @cerrada: 1 cuando la etapa productora ya no insertará más trabajos
+ * @integralOcupacion: Suma de cuenta × Δt (trabajos·us) entre cambios de cuenta
+ * @ultimoCambio: Instante (us) del último cambio de cuenta
+ * @inicio: Instante (us) en que se creó la cola
+ * @maxOcupacion: Ocupación máxima observada
+ *
+ * El productor se bloquea cuando la cola está llena y el consumidor cuando
+ * está vacía; así la memoria en vuelo queda limitada por la capacidad.
+ */
+struct cola {
+    struct trabajo **datos;
+    int capacidad, cabeza, cuenta, cerrada;
+    double integralOcupacion, ultimoCambio, inicio;
+    int maxOcupacion;
+    pthread_mutex_t mutex;
+    pthread_cond_t noVacia, noLlena;
+};
+
+/**
+ * struct etapa - Estadísticas de una etapa de la tubería
+ * @nombre: Nombre de la etapa para el reporte
+ * @trabajos: Trabajos completados por la etapa
+ * @ocupado: Tiempo (us) dedicado a trabajo útil, sin contar esperas en colas
+ */
+struct etapa {
+    const char *nombre;
+    int trabajos;
+    double ocupado;
+};
+
+/* Configuración global compartida por todas las etapas */
+int N, numHilos, numTrabajos;
+struct cola colaMultiplicar, colaVerificar;
+struct etapa etapas[3] = {{"generar", 0, 0.0}, {"multiplicar", 0, 0.0}, {"verificar", 0, 0.0}};
+int erroresVerificacion = 0;
+double sumaControl = 0.0;
+
+/**
+ * iniCola - Inicializa una cola acotada vacía
+ * @q: Cola a inicializar
+ * @capacidad: Número máximo de trabajos en espera
+ */
+void iniCola(struct cola *q, int capacidad) {
+    q->datos = (struct trabajo **)malloc(capacidad * sizeof(struct trabajo *));
+    if (!q->datos) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para la cola\n");
+        exit(1);
+    }
+    q->capacidad = capacidad;
+    q->cabeza = q->cuenta = q->cerrada = 0;
+    q->integralOcupacion = 0.0;
+    q->inicio = q->ultimoCambio = tiempoActual();
+    q->maxOcupacion = 0;
+    pthread_mutex_init(&q->mutex, NULL);
+    pthread_cond_init(&q->noVacia, NULL);
+    pthread_cond_init(&q->noLlena, NULL);
+}
+
+/**
+ * acumularOcupacion - Suma a la integral el tiempo pasado con la cuenta actual
+ * @q: Cola (con el mutex tomado), justo antes de cambiar su cuenta
+ *
+ * Así el promedio pondera cada ocupación por el tiempo que duró, y no por
+ * cuántas operaciones la observaron.
+ */
+void acumularOcupacion(struct cola *q) {
+    double ahora = tiempoActual();
+    q->integralOcupacion += q->cuenta * (ahora - q->ultimoCambio);
+    q->ultimoCambio = ahora;
+}
+
+/**
+ * ocupacionPromedio - Ocupación promedio en el tiempo desde que se creó la cola
+ * @q: Cola (ya sin productores ni consumidores)
+ * @fin: Instante (us) en que termina la medición
+ *
+ * @return: Integral de la ocupación dividida entre el tiempo transcurrido
+ */
+double ocupacionPromedio(struct cola *q, double fin) {
+    double integral = q->integralOcupacion + q->cuenta * (fin - q->ultimoCambio);
+    return (fin > q->inicio) ? integral / (fin - q->inicio) : 0.0;
+}
+
+/**
+ * encolar - Inserta un trabajo, bloqueando mientras la cola esté llena
+ * @q: Cola destino
+ * @t: Trabajo a insertar
+ */
+void encolar(struct cola *q, struct trabajo *t) {
+    pthread_mutex_lock(&q->mutex);
+    while (q->cuenta == q->capacidad) {
+        pthread_cond_wait(&q->noLlena, &q->mutex);
+    }
+    q->datos[(q->cabeza + q->cuenta) % q->capacidad] = t;
+    acumularOcupacion(q);
+    q->cuenta++;
+    if (q->cuenta > q->maxOcupacion) q->maxOcupacion = q->cuenta;
+    pthread_cond_signal(&q->noVacia);
+    pthread_mutex_unlock(&q->mutex);
+}
+
+/**
+ * desencolar - Extrae el siguiente trabajo, bloqueando mientras esté vacía
+ * @q: Cola origen
+ *
+ * @return: Trabajo extraído, o NULL si la cola está cerrada y vacía
+ */
+struct trabajo *desencolar(struct cola *q) {
+    struct trabajo *t = NULL;
+
+    pthread_mutex_lock(&q->mutex);
+    while (q->cuenta == 0 && !q->cerrada) {
+        pthread_cond_wait(&q->noVacia, &q->mutex);
+    }
+    if (q->cuenta > 0) {
+        t = q->datos[q->cabeza];
+        q->cabeza = (q->cabeza + 1) % q->capacidad;
+        acumularOcupacion(q);
+        q->cuenta--;
+        pthread_cond_signal(&q->noLlena);
+    }
+    pthread_mutex_unlock(&q->mutex);
+    return t;
+}
+
+/**
+ * cerrarCola - Indica que el productor no insertará más trabajos
+ * @q: Cola a cerrar
+ */
+void cerrarCola(struct cola *q) {
+    pthread_mutex_lock(&q->mutex);
+    q->cerrada = 1;
+    pthread_cond_broadcast(&q->noVacia);
+    pthread_mutex_unlock(&q->mutex);
+}
+
+/**
+ * destruirCola - Libera los recursos de una cola
+ * @q: Cola a destruir
+ */
+void destruirCola(struct cola *q) {
+    pthread_mutex_destroy(&q->mutex);
+    pthread_cond_destroy(&q->noVacia);
+    pthread_cond_destroy(&q->noLlena);
+    free(q->datos);
+}
+
+/**
+ * struct parametros - Parámetros de cada hilo de la etapa de multiplicación
+ * @t: Trabajo que se está multiplicando
+ * @filaI: Fila inicial del rango asignado (inclusiva)
+ * @filaF: Fila final del rango asignado (exclusiva)
+ */
+struct parametros {
+    struct trabajo *t;
+    int filaI, filaF;
+};
+
+/**
+ * multiMatrixThread - Hilo de cómputo: multiplica un rango de filas del trabajo
+ * @variables: Puntero a estructura de parámetros del hilo
+ *
+ * @return: NULL (requerido por pthread)
+ */
+void *multiMatrixThread(void *variables) {
+    struct parametros *data = (struct parametros *)variables;
+    multiMatrix(data->t->mA, data->t->mB, data->t->mC, N, data->filaI, data->filaF);
+    pthread_exit(NULL);
+}
+
+/**
+ * etapaGenerar - Etapa 1: reserva e inicializa las matrices de cada trabajo
+ * @arg: No utilizado
+ *
+ * Es la única etapa que llama a rand(), por lo que iniMatrix() no
+ * necesita ser reentrante.
+ */
+void *etapaGenerar(void *arg) {
+    (void)arg;
+    for (int id = 0; id < numTrabajos; id++) {
+        double t0 = tiempoActual();
+
+        struct trabajo *t = (struct trabajo *)malloc(sizeof(struct trabajo));
+        if (!t) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para el trabajo %d\n", id);
+            exit(1);
+        }
+        t->id = id;
+        t->mA = (double *)calloc(N * N, sizeof(double));
+        t->mB = (double *)calloc(N * N, sizeof(double));
+        t->mC = (double *)calloc(N * N, sizeof(double));
+        if (!t->mA || !t->mB || !t->mC) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para matrices\n");
+            exit(1);
+        }
+        iniMatrix(t->mA, t->mB, N);
+
+        etapas[0].ocupado += tiempoActual() - t0;
+        etapas[0].trabajos++;
+        encolar(&colaMultiplicar, t);
+    }
+    cerrarCola(&colaMultiplicar);
+    return NULL;
+}
+
+/**
+ * etapaMultiplicar - Etapa 2: multiplica cada trabajo con numHilos hilos
+ * @arg: No utilizado
+ *
+ * Reparte las filas igual que mmClasicaFork (el último hilo toma el
+ * residuo) y usa multiMatrix() de la biblioteca como núcleo de cómputo.
+ */
+void *etapaMultiplicar(void *arg) {
+    (void)arg;
+    pthread_t p[numHilos];
+    struct parametros datos[numHilos];
+    struct trabajo *t;
+    int filasPorHilo = N / numHilos;
+
+    while ((t = desencolar(&colaMultiplicar)) != NULL) {
+        double t0 = tiempoActual();
+
+        for (int j = 0; j < numHilos; j++) {
+            datos[j].t = t;
+            datos[j].filaI = j * filasPorHilo;
+            datos[j].filaF = (j == numHilos - 1) ? N : datos[j].filaI + filasPorHilo;
+            if (pthread_create(&p[j], NULL, multiMatrixThread, (void *)&datos[j]) != 0) {
+                fprintf(stderr, "Error: No se pudo crear hilo %d\n", j);
+                exit(1);
+            }
+        }
+        for (int j = 0; j < numHilos; j++) {
+            pthread_join(p[j], NULL);
+        }
+
+        etapas[1].ocupado += tiempoActual() - t0;
+        etapas[1].trabajos++;
+        encolar(&colaVerificar, t);
+    }
+    cerrarCola(&colaVerificar);
+    return NULL;
+}
+
+/**
+ * etapaVerificar - Etapa 3: verifica, almacena el resultado y libera memoria
+ * @arg: No utilizado
+ *
+ * Para matrices pequeñas verifica el producto completo, igual que los
+ * demás programas. Para matrices grandes acumula una suma de control de C,
+ * que obliga a recorrer el resultado como lo haría una escritura a disco.
+ */
+void *etapaVerificar(void *arg) {
+    (void)arg;
+    struct trabajo *t;
+
+    while ((t = desencolar(&colaVerificar)) != NULL) {
+        double t0 = tiempoActual();
+
+        if (N < 9) {
+            impMatrix(t->mC, N);
+            if (!verificarMultiplicacion(t->mA, t->mB, t->mC, N)) {
+                erroresVerificacion++;
+            }
+        }
+        for (int i = 0; i < N * N; i++) {
+            sumaControl += t->mC[i];
+        }
+
+        free(t->mA);
+        free(t->mB);
+        free(t->mC);
+        free(t);
+
+        etapas[2].ocupado += tiempoActual() - t0;
+        etapas[2].trabajos++;
+    }
+    return NULL;
+}
+
+/**
+ * main - Programa principal para multiplicación en tubería
+ * @argc: Cantidad de argumentos de línea de comandos
+ * @argv: Vector de argumentos [programa, tamaño_matriz, num_hilos,
+ *        num_trabajos, capacidad_cola]
+ *
+ * Algoritmo:
+ * 1. Valida argumentos de entrada
+ * 2. Crea dos colas acotadas entre las tres etapas
+ * 3. Lanza un hilo por etapa (generar, multiplicar, verificar)
+ * 4. Espera a que la última etapa procese todos los trabajos
+ * 5. Mide el tiempo total y reporta rendimiento y ocupación por etapa
+ *
+ * @return: 0 si éxito, 1 si error
+ */
+int main(int argc, char *argv[]) {
+    /* Validación de argumentos */
+    if (argc < 3) {
+        printf("\n \t\tUse: $./mmPipelinePosix tamMatriz numHilos [numTrabajos] [capacidad]\n");
+        printf("\t\ttamMatriz: Dimensión de la matriz cuadrada (NxN)\n");
+        printf("\t\tnumHilos: Número de hilos POSIX de la etapa de multiplicación\n");
+        printf("\t\tnumTrabajos: Multiplicaciones a procesar (por defecto 8)\n");
+        printf("\t\tcapacidad: Trabajos en espera por cola (por defecto 2)\n\n");
+        exit(0);
+    }
+
+    N = atoi(argv[1]);
+    numHilos = atoi(argv[2]);
+    numTrabajos = (argc > 3) ? atoi(argv[3]) : 8;
+    int capacidad = (argc > 4) ? atoi(argv[4]) : 2;
+
+    if (N <= 0 || numHilos <= 0 || numTrabajos <= 0 || capacidad <= 0) {
+        fprintf(stderr, "Error: Todos los argumentos deben ser positivos\n");
+        exit(1);
+    }
+
+    pthread_t hiloEtapa[3];
+    void *(*funcionEtapa[3])(void *) = {etapaGenerar, etapaMultiplicar, etapaVerificar};
+
+    srand(time(NULL));
+    iniCola(&colaMultiplicar, capacidad);
+    iniCola(&colaVerificar, capacidad);
+
+    /* Inicio de medición de tiempo: incluye las tres etapas solapadas */
+    InicioEnergia();
+    InicioMuestra();
+    double inicio = tiempoActual();
+
+    for (int e = 0; e < 3; e++) {
+        if (pthread_create(&hiloEtapa[e], NULL, funcionEtapa[e], NULL) != 0) {
+            fprintf(stderr, "Error: No se pudo crear la etapa %s\n", etapas[e].nombre);
+            exit(1);
+        }
+    }
+    for (int e = 0; e < 3; e++) {
+        pthread_join(hiloEtapa[e], NULL);
+    }
+
+    /* Fin de medición de tiempo */
+    double fin = tiempoActual();
+    double total = fin - inicio;
+    FinMuestra();
+    FinEnergia(2.0 * N * N * N * numTrabajos);
+
+    /* Reporte por etapa: rendimiento (trabajos/s) y fracción del tiempo ocupada */
+    printf("\nEtapa        Trabajos  Ocupado(us)  Trabajos/s  Utilizacion\n");
+    for (int e = 0; e < 3; e++) {
+        double ocupado = etapas[e].ocupado;
+        printf("%-12s %8d %12.0f %11.2f %11.1f%%\n", etapas[e].nombre, etapas[e].trabajos,
+               ocupado, ocupado > 0 ? etapas[e].trabajos / (ocupado / 1e6) : 0.0,
+               100.0 * ocupado / total);
+    }
+    printf("Tubería: %.2f trabajos/s en total\n", numTrabajos / (total / 1e6));
+
+    /* Reporte por cola: ocupación promedio en el tiempo y máxima frente a la capacidad */
+    struct cola *colas[2] = {&colaMultiplicar, &colaVerificar};
+    const char *nombresColas[2] = {"generar->multiplicar", "multiplicar->verificar"};
+    for (int q = 0; q < 2; q++) {
+        printf("Cola %-24s ocupación promedio (en el tiempo) %.2f, máxima %d de %d\n",
+               nombresColas[q], ocupacionPromedio(colas[q], fin),
+               colas[q]->maxOcupacion, colas[q]->capacidad);
+    }
+
+    /* Verificación de correctitud para matrices pequeñas */
+    if (N < 9) {
+        if (erroresVerificacion == 0) {
+            printf("\n[OK] Verificación: Multiplicación correcta\n");
+        } else {
+            printf("\n[ERROR] Verificación: %d multiplicaciones incorrectas\n", erroresVerificacion);
+        }
+    } else {
+        printf("Suma de control de los resultados: %.6e\n", sumaControl);
+    }
+
+    /* Liberación de recursos */
+    destruirCola(&colaMultiplicar);
+    destruirCola(&colaVerificar);
+
+    return 0;
+}
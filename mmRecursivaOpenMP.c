@@ -0,0 +1,122 @@
+/*#######################################################################################
+#* Pontificia Universidad Javeriana
+#* Fecha: Noviembre 2025
+#* Autores: Juan David Garzon Ballen
+#*          Juan Pablo Sanchez
+#* Materia: Sistemas Operativos
+#* Tema: Taller de Evaluación de Rendimiento
+#* Programa: Multiplicación de Matrices - Algoritmo Recursivo con OpenMP
+#* Descripción: Programa principal que implementa multiplicación de matrices
+#*              con el algoritmo recursivo cache-oblivious de mmCommon
+#*              (multiMatrixRecursiva). La recursión divide la mayor dimensión
+#*              del problema hasta que los bloques caben en caché, sin un
+#*              tamaño de bloque ajustado por máquina. Las mitades
+#*              independientes se reparten entre hilos como tareas OpenMP.
+#* Versión: Paralelismo con OpenMP - Algoritmo Recursivo (tareas)
+######################################################################################*/
+
+#include "mmCommon.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <omp.h>
+
+/* Dimensión máxima verificada: por encima de BASE_RECURSIVA y de UMBRAL_TAREA,
+ * de modo que se prueban las divisiones de M, N y K y las tareas OpenMP */
+#define N_MAX_VERIFICACION 128
+
+/**
+ * multiMatrixRecursivaOpenMP - Multiplicación recursiva con tareas OpenMP
+ * @mA: Puntero a la matriz A (multiplicando)
+ * @mB: Puntero a la matriz B (multiplicador)
+ * @mC: Puntero a la matriz resultado C (producto)
+ * @D: Dimensión de las matrices cuadradas (D x D)
+ *
+ * Crea el equipo de hilos y un solo hilo inicia la recursión sobre todas
+ * las filas; las tareas que genera multiMatrixRecursiva() son tomadas
+ * por el resto del equipo.
+ */
+void multiMatrixRecursivaOpenMP(double *mA, double *mB, double *mC, int D) {
+    #pragma omp parallel
+    {
+        #pragma omp single
+        multiMatrixRecursiva(mA, mB, mC, D, 0, D);
+    }
+}
+
+/**
+ * main - Programa principal para multiplicación recursiva con OpenMP
+ * @argc: Cantidad de argumentos de línea de comandos
+ * @argv: Vector de argumentos [programa, tamaño_matriz, num_hilos]
+ *
+ * Algoritmo:
+ * 1. Valida argumentos de entrada
+ * 2. Configura número de hilos OpenMP
+ * 3. Asigna memoria para matrices A, B, C
+ * 4. Inicializa matrices con valores aleatorios
+ * 5. Ejecuta la multiplicación recursiva con tareas OpenMP
+ * 6. Mide tiempo de ejecución y verifica correctitud (N <= 128)
+ * 7. Libera memoria
+ *
+ * @return: 0 si éxito, 1 si error
+ */
+int main(int argc, char *argv[]) {
+    /* Validación de argumentos */
+    if (argc < 3) {
+        printf("\n \t\tUse: $./mmRecursivaOpenMP SIZE Hilos\n");
+        printf("\t\tSIZE: Dimensión de la matriz cuadrada (NxN)\n");
+        printf("\t\tHilos: Número de hilos OpenMP paralelos\n\n");
+        exit(0);
+    }
+
+    int N = atoi(argv[1]);     // Dimensión de la matriz
+    int TH = atoi(argv[2]);    // Número de hilos OpenMP
+
+    /* Asignación de memoria dinámica para matrices (inicializada a cero) */
+    double *matrixA = (double *)calloc(N * N, sizeof(double));
+    double *matrixB = (double *)calloc(N * N, sizeof(double));
+    double *matrixC = (double *)calloc(N * N, sizeof(double));
+
+    if (!matrixA || !matrixB || !matrixC) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para matrices\n");
+        exit(1);
+    }
+
+    /* Configuración de OpenMP */
+    srand(time(NULL));
+    omp_set_num_threads(TH);
+
+    /* Inicialización de matrices con valores aleatorios */
+    iniMatrix(matrixA, matrixB, N);
+    impMatrix(matrixA, N);
+    impMatrix(matrixB, N);
+
+    /* Medición de tiempo de ejecución de la multiplicación */
+    InicioEnergia();
+    InicioMuestra();
+    multiMatrixRecursivaOpenMP(matrixA, matrixB, matrixC, N);
+    FinMuestra();
+    FinEnergia(2.0 * N * N * N);
+
+    /* Impresión del resultado (solo matrices pequeñas) */
+    impMatrix(matrixC, N);
+
+    /* Verificación de correctitud: se imprime para matrices pequeñas; hasta
+     * N_MAX_VERIFICACION (recursión con divisiones y tareas) solo se informa
+     * un error, para no alterar la salida de tiempos de los barridos */
+    if (N <= N_MAX_VERIFICACION) {
+        if (verificarMultiplicacion(matrixA, matrixB, matrixC, N)) {
+            if (N < 9) printf("\n[OK] Verificación: Multiplicación correcta\n");
+        } else {
+            printf("\n[ERROR] Verificación: Multiplicación incorrecta\n");
+            return 1;
+        }
+    }
+
+    /* Liberación de memoria */
+    free(matrixA);
+    free(matrixB);
+    free(matrixC);
+
+    return 0;
+}
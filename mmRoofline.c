@@ -0,0 +1,155 @@
+/*#######################################################################################
+#* Pontificia Universidad Javeriana
+#* Fecha: Noviembre 2025
+#* Autores: Juan David Garzon Ballen
+#*          Juan Pablo Sanchez
+#* Materia: Sistemas Operativos
+#* Tema: Taller de Evaluación de Rendimiento
+#* Programa: Microbenchmarks de techo de rendimiento (roofline) con OpenMP
+#* Descripción: Mide los dos techos del modelo roofline para un número de hilos:
+#*              (1) pico de cómputo en GFLOP/s, con cadenas independientes de
+#*              multiplicación-suma que no tocan memoria, y (2) ancho de banda
+#*              de memoria en GB/s, con el kernel "triad" de STREAM sobre
+#*              arreglos mucho mayores que la caché. Se compila con las mismas
+#*              opciones que los programas OpenMP, por lo que el pico medido
+#*              corresponde al conjunto de instrucciones que usan los núcleos.
+#* Versión: Microbenchmarks OpenMP
+######################################################################################*/
+
+#include "mmCommon.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+
+/* Acumuladores independientes por hilo: suficientes para ocultar la
+ * latencia de la multiplicación-suma y mantener ocupadas las unidades */
+#define ACUMULADORES 16
+#define ITERACIONES_FLOPS 20000000L
+#define REPETICIONES 5
+
+/**
+ * medirPicoFlops - Mide el pico de cómputo de punto flotante
+ *
+ * Cada hilo actualiza ACUMULADORES valores con a = a*m + s, todo en
+ * registros. Se toma la mejor de REPETICIONES mediciones.
+ *
+ * @return: GFLOP/s alcanzados por el equipo de hilos
+ */
+double medirPicoFlops() {
+    double mejor = 0.0, control = 0.0;
+
+    for (int r = 0; r < REPETICIONES; r++) {
+        int hilos = 1;
+        double inicio = tiempoActual();
+
+        #pragma omp parallel reduction(+:control)
+        {
+            double acc[ACUMULADORES];
+            const double m = 0.999999, s = 1e-7;
+
+            #pragma omp single
+            hilos = omp_get_num_threads();
+
+            for (int v = 0; v < ACUMULADORES; v++) acc[v] = 1.0 + v;
+            for (long it = 0; it < ITERACIONES_FLOPS; it++) {
+                #pragma omp simd
+                for (int v = 0; v < ACUMULADORES; v++) {
+                    acc[v] = acc[v] * m + s;
+                }
+            }
+            for (int v = 0; v < ACUMULADORES; v++) control += acc[v];
+        }
+
+        double segundos = (tiempoActual() - inicio) / 1e6;
+        double gflops = 2.0 * ACUMULADORES * ITERACIONES_FLOPS * hilos / segundos / 1e9;
+        if (gflops > mejor) mejor = gflops;
+    }
+
+    /* Uso del resultado para que el compilador no elimine el cálculo */
+    if (control == 0.0) printf("\n");
+    return mejor;
+}
+
+/**
+ * medirAnchoBanda - Mide el ancho de banda de memoria con STREAM triad
+ * @n: Elementos de cada uno de los tres arreglos
+ *
+ * a[i] = b[i] + s*c[i] mueve 24 bytes por elemento (convención de STREAM,
+ * sin contar la lectura previa de a por escritura). Los arreglos se
+ * inicializan en paralelo para que cada hilo toque primero sus páginas.
+ *
+ * @return: GB/s alcanzados por el equipo de hilos
+ */
+double medirAnchoBanda(long n) {
+    double *a = (double *)malloc(n * sizeof(double));
+    double *b = (double *)malloc(n * sizeof(double));
+    double *c = (double *)malloc(n * sizeof(double));
+    double mejor = 0.0;
+
+    if (!a || !b || !c) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para los arreglos\n");
+        exit(1);
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (long i = 0; i < n; i++) {
+        a[i] = 0.0;
+        b[i] = 1.0;
+        c[i] = 2.0;
+    }
+
+    for (int r = 0; r < REPETICIONES; r++) {
+        double inicio = tiempoActual();
+
+        #pragma omp parallel for schedule(static)
+        for (long i = 0; i < n; i++) {
+            a[i] = b[i] + 3.0 * c[i];
+        }
+
+        double segundos = (tiempoActual() - inicio) / 1e6;
+        double gbs = 24.0 * n / segundos / 1e9;
+        if (gbs > mejor) mejor = gbs;
+    }
+
+    if (a[n / 2] != 7.0) printf("Advertencia: resultado inesperado en triad\n");
+
+    free(a);
+    free(b);
+    free(c);
+    return mejor;
+}
+
+/**
+ * main - Programa principal de los microbenchmarks de roofline
+ * @argc: Cantidad de argumentos de línea de comandos
+ * @argv: Vector de argumentos [programa, num_hilos, millones_elementos]
+ *
+ * Imprime una línea por techo con formato "CLAVE valor" para que
+ * escalamiento.py la procese.
+ *
+ * @return: 0 si éxito, 1 si error
+ */
+int main(int argc, char *argv[]) {
+    /* Validación de argumentos */
+    if (argc < 2) {
+        printf("\n \t\tUse: $./mmRoofline Hilos [MElementos]\n");
+        printf("\t\tHilos: Número de hilos OpenMP paralelos\n");
+        printf("\t\tMElementos: Millones de doubles por arreglo de STREAM (defecto 8)\n\n");
+        exit(0);
+    }
+
+    int TH = atoi(argv[1]);
+    long n = (argc > 2 ? atol(argv[2]) : 8) * 1000000L;
+
+    if (TH <= 0 || n <= 0) {
+        fprintf(stderr, "Error: Todos los argumentos deben ser positivos\n");
+        exit(1);
+    }
+
+    omp_set_num_threads(TH);
+
+    printf("PICO_GFLOPS %.3f\n", medirPicoFlops());
+    printf("ANCHO_BANDA_GBS %.3f\n", medirAnchoBanda(n));
+
+    return 0;
+}
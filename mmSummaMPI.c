@@ -0,0 +1,327 @@
+/*#######################################################################################
+#* Pontificia Universidad Javeriana
+#* Fecha: Noviembre 2025
+#* Autores: Juan David Garzon Ballen
+#*          Juan Pablo Sanchez
+#* Materia: Sistemas Operativos
+#* Tema: Taller de Evaluación de Rendimiento
+#* Programa: Multiplicación de Matrices - Algoritmo SUMMA distribuido con MPI
+#* Descripción: Programa principal que reparte A, B y C en bloques sobre una
+#*              malla de q x q procesos MPI (distribución 2-D por bloques).
+#*              En cada paso k, el proceso de la columna k difunde su bloque
+#*              de A por su fila de la malla y el de la fila k difunde su
+#*              bloque de B por su columna; cada proceso acumula el producto
+#*              de los bloques recibidos con multiMatrixAcum() de mmCommon.
+#*              Las difusiones del paso k+1 se inician antes de calcular el
+#*              paso k para solapar comunicación y cómputo.
+#*              Igual que mmClasicaFork reparte filas entre procesos en una
+#*              máquina, aquí los bloques se reparten entre nodos.
+#* Versión: Paralelismo con Procesos MPI - SUMMA
+######################################################################################*/
+
+#include "mmCommon.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <mpi.h>
+
+/* Filas de bloque calculadas entre dos llamadas a MPI_Testall.
+ * Las difusiones no bloqueantes solo avanzan cuando el proceso entra a MPI,
+ * así que se consulta periódicamente mientras se calcula. */
+#define FILAS_ENTRE_PRUEBAS 32
+
+/**
+ * struct malla - Posición del proceso en la malla y comunicadores derivados
+ * @q: Lado de la malla (q x q procesos)
+ * @fila: Fila del proceso en la malla
+ * @col: Columna del proceso en la malla
+ * @comm: Comunicador cartesiano de toda la malla
+ * @commFila: Procesos de la misma fila (rango = columna)
+ * @commCol: Procesos de la misma columna (rango = fila)
+ */
+struct malla {
+    int q, fila, col;
+    MPI_Comm comm, commFila, commCol;
+};
+
+/**
+ * empaquetarBloques - Reordena una matriz N x N en bloques contiguos por rango
+ * @mat: Matriz completa N x N (por filas)
+ * @envio: Destino con P bloques de nb x nb, en orden de rango de la malla
+ * @N: Dimensión real de la matriz
+ * @nb: Dimensión de cada bloque (N redondeado hacia arriba a múltiplo de q)
+ * @m: Malla de procesos
+ *
+ * Las posiciones que exceden N se rellenan con ceros, por lo que N no
+ * necesita ser múltiplo de q.
+ */
+void empaquetarBloques(double *mat, double *envio, int N, int nb, struct malla *m) {
+    int coords[2];
+    for (int r = 0; r < m->q * m->q; r++) {
+        MPI_Cart_coords(m->comm, r, 2, coords);
+        double *bloque = envio + (long)r * nb * nb;
+        for (int i = 0; i < nb; i++) {
+            for (int j = 0; j < nb; j++) {
+                int gi = coords[0] * nb + i, gj = coords[1] * nb + j;
+                bloque[i * nb + j] = (gi < N && gj < N) ? mat[gi * N + gj] : 0.0;
+            }
+        }
+    }
+}
+
+/**
+ * desempaquetarBloques - Operación inversa de empaquetarBloques()
+ * @recibido: P bloques de nb x nb en orden de rango de la malla
+ * @mat: Matriz completa N x N de destino
+ * @N: Dimensión real de la matriz
+ * @nb: Dimensión de cada bloque
+ * @m: Malla de procesos
+ */
+void desempaquetarBloques(double *recibido, double *mat, int N, int nb, struct malla *m) {
+    int coords[2];
+    for (int r = 0; r < m->q * m->q; r++) {
+        MPI_Cart_coords(m->comm, r, 2, coords);
+        double *bloque = recibido + (long)r * nb * nb;
+        for (int i = 0; i < nb; i++) {
+            for (int j = 0; j < nb; j++) {
+                int gi = coords[0] * nb + i, gj = coords[1] * nb + j;
+                if (gi < N && gj < N) mat[gi * N + gj] = bloque[i * nb + j];
+            }
+        }
+    }
+}
+
+/**
+ * iniciarDifusion - Inicia las difusiones de los bloques del paso k
+ * @m: Malla de procesos
+ * @k: Paso de SUMMA (columna de A y fila de B que se difunden)
+ * @locA: Bloque local de A
+ * @locB: Bloque local de B
+ * @bufA: Buffer que recibirá el bloque A(fila, k)
+ * @bufB: Buffer que recibirá el bloque B(k, col)
+ * @tb: Elementos por bloque (nb x nb)
+ * @req: Dos solicitudes MPI (A y B) para completar después
+ */
+void iniciarDifusion(struct malla *m, int k, double *locA, double *locB,
+                     double *bufA, double *bufB, int tb, MPI_Request req[2]) {
+    if (m->col == k) memcpy(bufA, locA, tb * sizeof(double));
+    if (m->fila == k) memcpy(bufB, locB, tb * sizeof(double));
+    MPI_Ibcast(bufA, tb, MPI_DOUBLE, k, m->commFila, &req[0]);
+    MPI_Ibcast(bufB, tb, MPI_DOUBLE, k, m->commCol, &req[1]);
+}
+
+/**
+ * summa - Producto distribuido C = A × B con difusiones solapadas
+ * @m: Malla de procesos
+ * @locA: Bloque local de A (nb x nb)
+ * @locB: Bloque local de B (nb x nb)
+ * @locC: Bloque local de C (nb x nb), se acumula sobre ceros
+ * @nb: Dimensión de cada bloque
+ * @tComp: Tiempo de cómputo acumulado en segundos (salida)
+ * @tComm: Tiempo de comunicación no solapada acumulado en segundos (salida)
+ *
+ * Usa doble buffer: mientras se multiplican los bloques del paso k
+ * (buffer k % 2), llegan los del paso k+1 al otro buffer.
+ */
+void summa(struct malla *m, double *locA, double *locB, double *locC, int nb,
+           double *tComp, double *tComm) {
+    int tb = nb * nb, flag;
+    double *bufA[2], *bufB[2];
+    MPI_Request req[2][2];
+
+    for (int s = 0; s < 2; s++) {
+        bufA[s] = (double *)malloc(tb * sizeof(double));
+        bufB[s] = (double *)malloc(tb * sizeof(double));
+        if (!bufA[s] || !bufB[s]) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para buffers\n");
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+    }
+
+    double t = MPI_Wtime();
+    iniciarDifusion(m, 0, locA, locB, bufA[0], bufB[0], tb, req[0]);
+    *tComm += MPI_Wtime() - t;
+
+    for (int k = 0; k < m->q; k++) {
+        int s = k % 2;
+
+        /* Espera de los bloques del paso k (lo que no se alcanzó a solapar) */
+        t = MPI_Wtime();
+        MPI_Waitall(2, req[s], MPI_STATUSES_IGNORE);
+        if (k + 1 < m->q) {
+            iniciarDifusion(m, k + 1, locA, locB, bufA[1 - s], bufB[1 - s], tb, req[1 - s]);
+        }
+        *tComm += MPI_Wtime() - t;
+
+        /* Cómputo del paso k por tramos, dejando avanzar las difusiones */
+        for (int f = 0; f < nb; f += FILAS_ENTRE_PRUEBAS) {
+            int fF = (f + FILAS_ENTRE_PRUEBAS < nb) ? f + FILAS_ENTRE_PRUEBAS : nb;
+            t = MPI_Wtime();
+            multiMatrixAcum(bufA[s], bufB[s], locC, nb, f, fF);
+            *tComp += MPI_Wtime() - t;
+
+            if (k + 1 < m->q) {
+                t = MPI_Wtime();
+                MPI_Testall(2, req[1 - s], &flag, MPI_STATUSES_IGNORE);
+                *tComm += MPI_Wtime() - t;
+            }
+        }
+    }
+
+    for (int s = 0; s < 2; s++) {
+        free(bufA[s]);
+        free(bufB[s]);
+    }
+}
+
+/**
+ * main - Programa principal para multiplicación distribuida con SUMMA
+ * @argc: Cantidad de argumentos de línea de comandos
+ * @argv: Vector de argumentos [programa, tamaño_matriz]
+ *
+ * Algoritmo:
+ * 1. Valida argumentos y que el número de procesos sea un cuadrado (q x q)
+ * 2. Crea la malla cartesiana y los comunicadores de fila y columna
+ * 3. El proceso 0 inicializa A y B y reparte los bloques (MPI_Scatter)
+ * 4. Ejecuta SUMMA midiendo cómputo y comunicación por separado
+ * 5. El proceso 0 recoge C (MPI_Gather), reporta tiempos y verifica
+ * 6. Libera memoria y comunicadores
+ *
+ * Uso local: mpirun -np 4 ./mmSummaMPI 800
+ *
+ * @return: 0 si éxito, 1 si error
+ */
+int main(int argc, char *argv[]) {
+    int rango, P;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rango);
+    MPI_Comm_size(MPI_COMM_WORLD, &P);
+
+    /* Validación de argumentos */
+    if (argc < 2) {
+        if (rango == 0) {
+            printf("\n \t\tUse: $mpirun -np K ./mmSummaMPI SIZE\n");
+            printf("\t\tSIZE: Dimensión de la matriz cuadrada (NxN)\n");
+            printf("\t\tK: Número de procesos MPI, debe ser un cuadrado (1, 4, 9, ...)\n\n");
+        }
+        MPI_Finalize();
+        exit(0);
+    }
+
+    int N = atoi(argv[1]);    // Dimensión de la matriz
+    struct malla m;
+    m.q = (int)(sqrt((double)P) + 0.5);
+
+    if (N <= 0 || m.q * m.q != P) {
+        if (rango == 0) {
+            fprintf(stderr, "Error: SIZE debe ser positivo y el número de procesos un cuadrado\n");
+        }
+        MPI_Finalize();
+        exit(1);
+    }
+
+    /* Malla cartesiana q x q y comunicadores de fila y de columna */
+    int dims[2] = {m.q, m.q}, periodos[2] = {0, 0}, coords[2];
+    int conservarFila[2] = {0, 1}, conservarCol[2] = {1, 0};
+    MPI_Cart_create(MPI_COMM_WORLD, 2, dims, periodos, 0, &m.comm);
+    MPI_Comm_rank(m.comm, &rango);
+    MPI_Cart_coords(m.comm, rango, 2, coords);
+    m.fila = coords[0];
+    m.col = coords[1];
+    MPI_Cart_sub(m.comm, conservarFila, &m.commFila);
+    MPI_Cart_sub(m.comm, conservarCol, &m.commCol);
+
+    /* Bloques locales: N se redondea hacia arriba a múltiplo de q */
+    int nb = (N + m.q - 1) / m.q;
+    int tb = nb * nb;
+    double *locA = (double *)calloc(tb, sizeof(double));
+    double *locB = (double *)calloc(tb, sizeof(double));
+    double *locC = (double *)calloc(tb, sizeof(double));
+    double *matA = NULL, *matB = NULL, *matC = NULL, *bloques = NULL;
+
+    if (!locA || !locB || !locC) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para bloques\n");
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    /* El proceso 0 inicializa las matrices completas */
+    if (rango == 0) {
+        matA = (double *)calloc(N * N, sizeof(double));
+        matB = (double *)calloc(N * N, sizeof(double));
+        matC = (double *)calloc(N * N, sizeof(double));
+        bloques = (double *)malloc((long)P * tb * sizeof(double));
+        if (!matA || !matB || !matC || !bloques) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para matrices\n");
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+        srand(time(NULL));
+        iniMatrix(matA, matB, N);
+        impMatrix(matA, N);
+        impMatrix(matB, N);
+    }
+
+    /* Reparto de bloques de A y B */
+    if (rango == 0) empaquetarBloques(matA, bloques, N, nb, &m);
+    MPI_Scatter(bloques, tb, MPI_DOUBLE, locA, tb, MPI_DOUBLE, 0, m.comm);
+    if (rango == 0) empaquetarBloques(matB, bloques, N, nb, &m);
+    MPI_Scatter(bloques, tb, MPI_DOUBLE, locB, tb, MPI_DOUBLE, 0, m.comm);
+
+    /* Inicio de medición de tiempo (todos los procesos parten juntos) */
+    double tComp = 0.0, tComm = 0.0;
+    MPI_Barrier(m.comm);
+    /* La energía RAPL es la del nodo del rango 0, no la de todo el clúster */
+    if (rango == 0) InicioEnergia();
+    if (rango == 0) InicioMuestra();
+
+    summa(&m, locA, locB, locC, nb, &tComp, &tComm);
+
+    /* Fin de medición de tiempo cuando termina el proceso más lento */
+    MPI_Barrier(m.comm);
+    if (rango == 0) FinMuestra();
+    if (rango == 0) FinEnergia(2.0 * N * N * N);
+
+    /* Tiempos de cómputo y comunicación del proceso más lento en cada uno */
+    double maxComp, maxComm;
+    MPI_Reduce(&tComp, &maxComp, 1, MPI_DOUBLE, MPI_MAX, 0, m.comm);
+    MPI_Reduce(&tComm, &maxComm, 1, MPI_DOUBLE, MPI_MAX, 0, m.comm);
+
+    /* Recolección de C en el proceso 0 */
+    MPI_Gather(locC, tb, MPI_DOUBLE, bloques, tb, MPI_DOUBLE, 0, m.comm);
+
+    if (rango == 0) {
+        desempaquetarBloques(bloques, matC, N, nb, &m);
+        printf("Malla %dx%d, bloque %dx%d: cómputo %.0f us, comunicación %.0f us "
+               "(máximo entre procesos)\n", m.q, m.q, nb, nb, maxComp * 1e6, maxComm * 1e6);
+
+        /* Impresión del resultado (solo matrices pequeñas) */
+        impMatrix(matC, N);
+
+        /* Verificación de correctitud para matrices pequeñas */
+        if (N < 9) {
+            if (verificarMultiplicacion(matA, matB, matC, N)) {
+                printf("\n[OK] Verificación: Multiplicación correcta\n");
+            } else {
+                printf("\n[ERROR] Verificación: Multiplicación incorrecta\n");
+            }
+        }
+
+        free(matA);
+        free(matB);
+        free(matC);
+        free(bloques);
+    }
+
+    /* Liberación de memoria y comunicadores */
+    free(locA);
+    free(locB);
+    free(locC);
+    MPI_Comm_free(&m.commFila);
+    MPI_Comm_free(&m.commCol);
+    MPI_Comm_free(&m.comm);
+    MPI_Finalize();
+
+    return 0;
+}
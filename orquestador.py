@@ -0,0 +1,340 @@
+#!/usr/bin/env python3
+"""
+Orquestador de Experimentos - Taller de Evaluación de Rendimiento
+Autores: Juan David Garzon Ballen, Juan Pablo Sanchez
+Pontificia Universidad Javeriana - Sistemas Operativos
+
+Reemplaza a lanzador.pl y ejecutar_todas_pruebas.sh para el barrido completo:
+- Lee la matriz de experimentos (programas × tamaños × hilos) de barrido.conf
+- Ejecuta a la vez las celdas pequeñas, cada una en núcleos disjuntos
+- Registra cada celda terminada en Resultados/.progreso.json y, si el
+  barrido se interrumpe, lo retoma donde quedó sin perder datos
+- Repite automáticamente las celdas cuyo coeficiente de variación es alto
+- Con [energia] medir = si, activa la medición RAPL de los programas
+  (MM_ENERGIA=1) y guarda sus líneas ENERGIA junto a cada tiempo
+
+Los archivos .dat se escriben completos al terminar cada celda (nunca se
+truncan a medias), con el mismo formato que usa analizar_resultados.py.
+
+Solo usa la biblioteca estándar de Python.
+"""
+
+import argparse
+import concurrent.futures
+import configparser
+import json
+import os
+import statistics
+import subprocess
+import sys
+import threading
+import time
+
+ARCHIVO_PROGRESO = '.progreso.json'
+
+# Serializa la impresión y el registro de progreso entre hilos
+cerrojo = threading.Lock()
+
+
+def leer_configuracion(ruta):
+    """
+    Lee barrido.conf y devuelve un diccionario con la configuración
+    """
+    cfg = configparser.ConfigParser()
+    if not cfg.read(ruta, encoding='utf-8'):
+        sys.exit(f"[ERROR] No se encuentra el archivo de configuración: {ruta}")
+
+    return {
+        'programas': cfg.get('barrido', 'programas').split(),
+        'tamanos': [int(x) for x in cfg.get('barrido', 'tamanos').split()],
+        'hilos': [int(x) for x in cfg.get('barrido', 'hilos').split()],
+        'repeticiones': cfg.getint('barrido', 'repeticiones'),
+        'directorio': cfg.get('barrido', 'directorio', fallback='Resultados'),
+        'tamano_max_concurrente': cfg.getint('concurrencia', 'tamano_max_concurrente', fallback=0),
+        'nucleos': parsear_nucleos(cfg.get('concurrencia', 'nucleos', fallback='todos')),
+        'cv_max': cfg.getfloat('ruido', 'cv_max', fallback=0.10),
+        'reintentos_max': cfg.getint('ruido', 'reintentos_max', fallback=2),
+        'energia': cfg.get('energia', 'medir', fallback='no').strip().lower() in ('si', 'sí'),
+    }
+
+
+def parsear_nucleos(texto):
+    """
+    Convierte "todos" o una lista como "0-3,6" en una lista de núcleos
+    """
+    if texto.strip() == 'todos':
+        return sorted(os.sched_getaffinity(0))
+
+    nucleos = []
+    for parte in texto.split(','):
+        if '-' in parte:
+            inicio, fin = parte.split('-')
+            nucleos.extend(range(int(inicio), int(fin) + 1))
+        elif parte.strip():
+            nucleos.append(int(parte))
+    return sorted(set(nucleos))
+
+
+def nombre_celda(programa, tamano, hilos):
+    """
+    Nombre de la celda, igual al del archivo .dat sin extensión
+
+    Las variantes "programa:argumento" quedan como programa_argumento.
+    """
+    return f"{programa.replace(':', '_')}-{tamano}-Hilos-{hilos}"
+
+
+def separar_programa(programa):
+    """
+    Separa "programa:argumento:..." en el ejecutable y sus argumentos extra
+
+    Los argumentos extra se pasan tras N e hilos, p. ej. mmClasicaFork:recursiva
+    ejecuta "./mmClasicaFork N hilos recursiva".
+    """
+    ejecutable, *extra = programa.split(':')
+    return ejecutable, extra
+
+
+def escribir_atomico(ruta, texto):
+    """
+    Escribe un archivo completo o no lo modifica (archivo temporal + rename)
+    """
+    temporal = ruta + '.tmp'
+    with open(temporal, 'w', encoding='utf-8') as f:
+        f.write(texto)
+        f.flush()
+        os.fsync(f.fileno())
+    os.replace(temporal, ruta)
+
+
+def cargar_progreso(directorio):
+    """
+    Carga el registro de celdas completadas (vacío si no existe)
+    """
+    ruta = os.path.join(directorio, ARCHIVO_PROGRESO)
+    if not os.path.exists(ruta):
+        return {}
+    with open(ruta, 'r', encoding='utf-8') as f:
+        return json.load(f)
+
+
+def guardar_progreso(directorio, progreso):
+    """
+    Guarda el registro de celdas completadas de forma atómica
+    """
+    escribir_atomico(os.path.join(directorio, ARCHIVO_PROGRESO),
+                     json.dumps(progreso, indent=1, sort_keys=True))
+
+
+def extraer_tiempo(salida):
+    """
+    Devuelve el primer valor numérico de la salida (tiempo de FinMuestra)
+    """
+    for linea in salida.splitlines():
+        try:
+            return float(linea.strip())
+        except ValueError:
+            continue
+    return None
+
+
+def extraer_energia(salida):
+    """
+    Devuelve la línea ENERGIA de la salida (None si no se midió)
+    """
+    for linea in salida.splitlines():
+        if linea.startswith('ENERGIA '):
+            return linea.strip()
+    return None
+
+
+def ejecutar_una_vez(programa, tamano, hilos, nucleos, energia=False):
+    """
+    Ejecuta el programa una vez fijado a los núcleos indicados
+
+    Devuelve (tiempo, línea ENERGIA o None), o (None, None) si falló.
+    """
+    def fijar_nucleos():
+        os.sched_setaffinity(0, nucleos)
+
+    ejecutable, extra = separar_programa(programa)
+    entorno = dict(os.environ, MM_ENERGIA='1') if energia else None
+    proceso = subprocess.run([f'./{ejecutable}', str(tamano), str(hilos)] + extra,
+                             stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                             text=True, preexec_fn=fijar_nucleos, env=entorno)
+    if proceso.returncode != 0:
+        return None, None
+    return extraer_tiempo(proceso.stdout), extraer_energia(proceso.stdout)
+
+
+def coeficiente_variacion(tiempos):
+    """
+    Desviación estándar / promedio (0 si hay menos de dos mediciones)
+    """
+    if len(tiempos) < 2 or statistics.mean(tiempos) == 0:
+        return 0.0
+    return statistics.pstdev(tiempos) / statistics.mean(tiempos)
+
+
+def ejecutar_celda(celda, cfg, nucleos):
+    """
+    Ejecuta todas las repeticiones de una celda y la repite si es ruidosa
+
+    Conserva el intento con menor coeficiente de variación. Devuelve la
+    entrada de progreso de la celda, o None si alguna ejecución falló.
+    """
+    programa, tamano, hilos = celda
+    mejor = None
+
+    for intento in range(1, cfg['reintentos_max'] + 2):
+        tiempos, energias = [], []
+        for _ in range(cfg['repeticiones']):
+            tiempo, energia = ejecutar_una_vez(programa, tamano, hilos, nucleos, cfg['energia'])
+            if tiempo is None:
+                return None
+            tiempos.append(tiempo)
+            energias.append(energia)
+
+        cv = coeficiente_variacion(tiempos)
+        if mejor is None or cv < mejor['cv']:
+            mejor = {'tiempos': tiempos, 'energias': energias, 'cv': cv}
+        if cv <= cfg['cv_max']:
+            break
+        with cerrojo:
+            print(f"  [RUIDO] {nombre_celda(*celda)}: CV={cv:.3f} > {cfg['cv_max']:.3f}, "
+                  f"intento {intento} de {cfg['reintentos_max'] + 1}")
+
+    ruta_dat = os.path.join(cfg['directorio'], nombre_celda(*celda) + '.dat')
+    escribir_atomico(ruta_dat, ''.join(f"{t:9.0f} \n" + (f"{e}\n" if e else '')
+                                       for t, e in zip(mejor['tiempos'], mejor['energias'])))
+
+    return {
+        'estado': 'completa',
+        'promedio': statistics.mean(mejor['tiempos']),
+        'cv': round(mejor['cv'], 4),
+        'intentos': intento,
+        'ruidosa': mejor['cv'] > cfg['cv_max'],
+        'nucleos': nucleos,
+    }
+
+
+class RepartoNucleos:
+    """
+    Asigna conjuntos disjuntos de núcleos a las celdas que corren a la vez
+    """
+
+    def __init__(self, nucleos):
+        self.libres = list(nucleos)
+        self.condicion = threading.Condition()
+
+    def tomar(self, cantidad):
+        with self.condicion:
+            while len(self.libres) < cantidad:
+                self.condicion.wait()
+            tomados, self.libres = self.libres[:cantidad], self.libres[cantidad:]
+            return tomados
+
+    def devolver(self, nucleos):
+        with self.condicion:
+            self.libres = sorted(self.libres + nucleos)
+            self.condicion.notify_all()
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Orquestador del barrido de experimentos')
+    parser.add_argument('--config', default='barrido.conf', help='archivo de configuración')
+    parser.add_argument('--reiniciar', action='store_true',
+                        help='ignora el progreso guardado y repite todo el barrido')
+    parser.add_argument('--listar', action='store_true',
+                        help='solo muestra las celdas pendientes, sin ejecutar')
+    args = parser.parse_args()
+
+    cfg = leer_configuracion(args.config)
+    os.makedirs(cfg['directorio'], exist_ok=True)
+
+    for programa in cfg['programas']:
+        ejecutable, _ = separar_programa(programa)
+        if not os.access(f'./{ejecutable}', os.X_OK):
+            sys.exit(f"[ERROR] No se encuentra el ejecutable: {ejecutable}\n"
+                     f"        Ejecute: make all")
+
+    progreso = {} if args.reiniciar else cargar_progreso(cfg['directorio'])
+
+    celdas = [(p, n, h) for p in cfg['programas'] for n in cfg['tamanos'] for h in cfg['hilos']]
+    pendientes = [c for c in celdas
+                  if progreso.get(nombre_celda(*c), {}).get('estado') != 'completa'
+                  or not os.path.exists(os.path.join(cfg['directorio'], nombre_celda(*c) + '.dat'))]
+
+    # Celdas pequeñas que caben junto a otras sin exceder los núcleos disponibles.
+    # RAPL mide todo el paquete: con energía, cada celda se ejecuta sola.
+    total_nucleos = len(cfg['nucleos'])
+    tamano_max = 0 if cfg['energia'] else cfg['tamano_max_concurrente']
+    concurrentes = [c for c in pendientes
+                    if c[1] <= tamano_max and c[2] < total_nucleos]
+    exclusivas = [c for c in pendientes if c not in concurrentes]
+
+    print("=" * 60)
+    print("  ORQUESTADOR DE EXPERIMENTOS - TALLER DE RENDIMIENTO")
+    print("=" * 60)
+    print(f"Celdas del barrido     : {len(celdas)}")
+    print(f"Completadas (retomado) : {len(celdas) - len(pendientes)}")
+    print(f"Pendientes concurrentes: {len(concurrentes)}")
+    print(f"Pendientes exclusivas  : {len(exclusivas)}")
+    print(f"Núcleos disponibles    : {cfg['nucleos']}")
+    print(f"Medición de energía    : {'sí (RAPL)' if cfg['energia'] else 'no'}")
+    print("=" * 60)
+
+    if args.listar:
+        for celda in pendientes:
+            print(f"  {nombre_celda(*celda)}")
+        return
+
+    inicio = time.time()
+    hechas = [len(celdas) - len(pendientes)]
+    reparto = RepartoNucleos(cfg['nucleos'])
+
+    def registrar(celda, resultado):
+        with cerrojo:
+            nombre = nombre_celda(*celda)
+            if resultado is None:
+                print(f"  [ERROR] {nombre}: falló una ejecución, se reintentará al retomar")
+                return
+            progreso[nombre] = resultado
+            guardar_progreso(cfg['directorio'], progreso)
+            hechas[0] += 1
+            marca = ' [RUIDOSA]' if resultado['ruidosa'] else ''
+            print(f"[{hechas[0]}/{len(celdas)}] {nombre}: {resultado['promedio']:.0f} us, "
+                  f"CV={resultado['cv']:.3f}, núcleos {resultado['nucleos']}{marca}")
+
+    def trabajador(celda):
+        nucleos = reparto.tomar(max(celda[2], 1))
+        try:
+            registrar(celda, ejecutar_celda(celda, cfg, nucleos))
+        finally:
+            reparto.devolver(nucleos)
+
+    # Fase 1: celdas pequeñas en paralelo sobre núcleos disjuntos
+    # (como mucho una celda por núcleo esperando a la vez)
+    with concurrent.futures.ThreadPoolExecutor(max_workers=max(total_nucleos, 1)) as grupo:
+        for futuro in [grupo.submit(trabajador, c) for c in concurrentes]:
+            futuro.result()
+
+    # Fase 2: celdas grandes de a una con todos los núcleos
+    for celda in exclusivas:
+        registrar(celda, ejecutar_celda(celda, cfg, cfg['nucleos']))
+
+    duracion = int(time.time() - inicio)
+    ruidosas = [n for n, r in progreso.items() if r.get('ruidosa')]
+    print("=" * 60)
+    print(f"Barrido terminado en {duracion // 60}m {duracion % 60}s")
+    print(f"Celdas completadas: {hechas[0]}/{len(celdas)}")
+    if ruidosas:
+        print(f"Celdas aún ruidosas tras reintentos: {len(ruidosas)}")
+        for nombre in sorted(ruidosas):
+            print(f"  - {nombre} (CV={progreso[nombre]['cv']:.3f})")
+    print(f"Resultados en: {cfg['directorio']}/")
+    print("=" * 60)
+
+
+if __name__ == "__main__":
+    main()
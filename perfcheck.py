@@ -0,0 +1,237 @@
+#!/usr/bin/env python3
+"""
+Detección de Regresiones de Rendimiento - Taller de Evaluación de Rendimiento
+Autores: Juan David Garzon Ballen, Juan Pablo Sanchez
+Pontificia Universidad Javeriana - Sistemas Operativos
+
+Ejecuta un conjunto corto y fijo de casos (programa, N, hilos) definido en
+la sección [perfcheck] de barrido.conf y lo compara con la línea base de
+esta máquina, guardada en baselines/<hostname>.json:
+- Un caso es REGRESIÓN si su mediana empeora más que el umbral y la
+  prueba U de Mann-Whitney (unilateral, exacta) da p < alfa
+- Las mejoras significativas se informan pero no fallan
+- Sale con código 1 si hay alguna regresión (para make perfcheck)
+
+Los tiempos de cada caso se guardan también en Resultados/perfcheck/ con
+el formato .dat de siempre, de modo que analizar_resultados.py los puede
+procesar. Solo usa la biblioteca estándar de Python.
+
+Uso:
+    ./perfcheck.py                 # compara con la línea base
+    ./perfcheck.py --guardar-base  # mide y guarda la línea base
+"""
+
+import argparse
+import configparser
+import datetime
+import json
+import os
+import socket
+import statistics
+import sys
+
+from orquestador import (ejecutar_una_vez, escribir_atomico, leer_configuracion, nombre_celda,
+                         separar_programa)
+
+DIRECTORIO_BASES = 'baselines'
+
+
+def leer_perfcheck(ruta):
+    """
+    Lee la sección [perfcheck] de barrido.conf
+    """
+    cfg = configparser.ConfigParser()
+    cfg.read(ruta, encoding='utf-8')
+    if not cfg.has_section('perfcheck'):
+        sys.exit(f"[ERROR] Falta la sección [perfcheck] en {ruta}")
+
+    casos = []
+    for texto in cfg.get('perfcheck', 'casos').split():
+        # El programa puede llevar variante: mmClasicaFork:recursiva:600:4
+        programa, tamano, hilos = texto.rsplit(':', 2)
+        casos.append((programa, int(tamano), int(hilos)))
+
+    return {
+        'casos': casos,
+        'repeticiones': cfg.getint('perfcheck', 'repeticiones'),
+        'umbral': cfg.getfloat('perfcheck', 'umbral'),
+        'alfa': cfg.getfloat('perfcheck', 'alfa'),
+    }
+
+
+def modelo_cpu():
+    """
+    Nombre del procesador según /proc/cpuinfo (vacío si no se puede leer)
+    """
+    try:
+        with open('/proc/cpuinfo') as f:
+            for linea in f:
+                if linea.startswith('model name'):
+                    return linea.split(':', 1)[1].strip()
+    except OSError:
+        pass
+    return ''
+
+
+def ruta_base():
+    """
+    Archivo de línea base de esta máquina
+    """
+    return os.path.join(DIRECTORIO_BASES, f"{socket.gethostname()}.json")
+
+
+def u_mann_whitney(x, y):
+    """
+    Estadístico U de x frente a y: pares (xi, yj) con xi > yj (empates 0.5)
+    """
+    return sum(1.0 if a > b else 0.5 if a == b else 0.0 for a in x for b in y)
+
+
+def p_mann_whitney(actual, base):
+    """
+    p-valor unilateral exacto de H1: los tiempos actuales son mayores
+
+    Cuenta, por programación dinámica, cuántas de las C(n+m, n) maneras de
+    repartir los rangos dan un U al menos tan grande como el observado
+    (distribución exacta sin empates; con pocas repeticiones la
+    aproximación normal no es fiable).
+    """
+    n, m = len(actual), len(base)
+    u = u_mann_whitney(actual, base)
+
+    # formas[i][j][k]: secuencias de i actuales y j base con U = k
+    formas = [[None] * (m + 1) for _ in range(n + 1)]
+    for i in range(n + 1):
+        for j in range(m + 1):
+            if i == 0 or j == 0:
+                formas[i][j] = {0: 1}
+                continue
+            # El mayor elemento es actual (aporta j al U) o es de la base
+            total = {}
+            for k, c in formas[i - 1][j].items():
+                total[k + j] = total.get(k + j, 0) + c
+            for k, c in formas[i][j - 1].items():
+                total[k] = total.get(k, 0) + c
+            formas[i][j] = total
+
+    distribucion = formas[n][m]
+    favorables = sum(c for k, c in distribucion.items() if k >= u)
+    return favorables / sum(distribucion.values())
+
+
+def medir_caso(caso, repeticiones, nucleos, directorio):
+    """
+    Ejecuta un caso (más una ejecución de calentamiento descartada)
+
+    Devuelve la lista de tiempos, o None si alguna ejecución falló.
+    """
+    programa, tamano, hilos = caso
+    if ejecutar_una_vez(programa, tamano, hilos, nucleos)[0] is None:
+        return None
+
+    tiempos = []
+    for _ in range(repeticiones):
+        tiempo, _ = ejecutar_una_vez(programa, tamano, hilos, nucleos)
+        if tiempo is None:
+            return None
+        tiempos.append(tiempo)
+
+    escribir_atomico(os.path.join(directorio, nombre_celda(*caso) + '.dat'),
+                     ''.join(f"{t:9.0f} \n" for t in tiempos))
+    return tiempos
+
+
+def comparar(actual, base, pc):
+    """
+    Clasifica un caso frente a su línea base
+
+    Devuelve (cambio relativo de la mediana, p-valor, estado).
+    """
+    cambio = statistics.median(actual) / statistics.median(base) - 1.0
+    if cambio > 0:
+        p = p_mann_whitney(actual, base)
+        estado = 'REGRESIÓN' if cambio > pc['umbral'] and p < pc['alfa'] else 'igual'
+    else:
+        p = p_mann_whitney(base, actual)
+        estado = 'mejora' if -cambio > pc['umbral'] and p < pc['alfa'] else 'igual'
+    return cambio, p, estado
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Detección de regresiones de rendimiento')
+    parser.add_argument('--config', default='barrido.conf', help='archivo de configuración')
+    parser.add_argument('--guardar-base', action='store_true',
+                        help='mide los casos y los guarda como línea base de esta máquina')
+    args = parser.parse_args()
+
+    cfg = leer_configuracion(args.config)
+    pc = leer_perfcheck(args.config)
+    directorio = os.path.join(cfg['directorio'], 'perfcheck')
+    os.makedirs(directorio, exist_ok=True)
+
+    for ejecutable in sorted({separar_programa(c[0])[0] for c in pc['casos']}):
+        if not os.access(f'./{ejecutable}', os.X_OK):
+            sys.exit(f"[ERROR] No se encuentra el ejecutable: {ejecutable}\n"
+                     f"        Ejecute: make all")
+
+    base = None
+    if not args.guardar_base:
+        if not os.path.exists(ruta_base()):
+            print(f"[ERROR] No hay línea base para esta máquina ({ruta_base()})")
+            print("        Ejecute: make perfcheck-baseline")
+            sys.exit(2)
+        with open(ruta_base(), 'r', encoding='utf-8') as f:
+            base = json.load(f)
+        if base.get('cpu') and base['cpu'] != modelo_cpu():
+            print(f"[AVISO] La línea base se midió en otro procesador: {base['cpu']}")
+
+    print("=" * 86)
+    print("  PERFCHECK - " + ("GUARDANDO LÍNEA BASE" if args.guardar_base else
+                             f"umbral {pc['umbral']:.0%}, alfa {pc['alfa']}, "
+                             f"{pc['repeticiones']} repeticiones"))
+    print("=" * 86)
+
+    medidos = {}
+    for caso in pc['casos']:
+        nombre = nombre_celda(*caso)
+        tiempos = medir_caso(caso, pc['repeticiones'], cfg['nucleos'], directorio)
+        if tiempos is None:
+            sys.exit(f"[ERROR] {nombre}: falló la ejecución")
+        medidos[nombre] = tiempos
+        if args.guardar_base:
+            print(f"  {nombre:36s} mediana {statistics.median(tiempos):12.0f} us")
+
+    if args.guardar_base:
+        os.makedirs(DIRECTORIO_BASES, exist_ok=True)
+        escribir_atomico(ruta_base(), json.dumps({
+            'host': socket.gethostname(),
+            'cpu': modelo_cpu(),
+            'fecha': datetime.datetime.now().isoformat(timespec='seconds'),
+            'casos': medidos,
+        }, indent=1, sort_keys=True))
+        print(f"Línea base guardada en {ruta_base()}")
+        return
+
+    print(f"{'Caso':36s} {'Base (us)':>12s} {'Actual (us)':>12s} {'Cambio':>8s} {'p':>7s}  Estado")
+    print("-" * 86)
+    regresiones = 0
+    for nombre, actual in medidos.items():
+        if nombre not in base['casos']:
+            print(f"{nombre:36s} {'-':>12s} {statistics.median(actual):12.0f} "
+                  f"{'-':>8s} {'-':>7s}  sin base")
+            continue
+        anterior = base['casos'][nombre]
+        cambio, p, estado = comparar(actual, anterior, pc)
+        regresiones += (estado == 'REGRESIÓN')
+        print(f"{nombre:36s} {statistics.median(anterior):12.0f} {statistics.median(actual):12.0f} "
+              f"{cambio:+8.1%} {p:7.4f}  {estado}")
+
+    print("=" * 86)
+    if regresiones:
+        print(f"[ERROR] {regresiones} caso(s) con regresión de rendimiento")
+        sys.exit(1)
+    print("[OK] Sin regresiones de rendimiento")
+
+
+if __name__ == "__main__":
+    main()